@@ -0,0 +1,433 @@
+///////////////////////////////////////////////////////////////////////
+// Analyzer.cpp - per-function code metrics from SemiExp streams     //
+// ver 1.3                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* SemiExp returns as soon as it reads '{' or '}', so every brace is the
+* last token of its semi-expression.  The analyzer keeps the current
+* brace depth and a stack of open functions, each remembering the depth
+* of its own opening brace; a '}' that returns to that depth closes the
+* function.  Branch tokens are charged to the innermost open function.
+* A header whose parentheses are still open at '{' (a lambda passed as
+* an argument) is treated as an ordinary block of the enclosing function.
+*
+* Build Process:
+* --------------
+* Required Files:
+*   Analyzer.h, Analyzer.cpp, ScannerPool.h, ScannerPool.cpp, SemiExp.h,
+*   SemiExp.cpp, SemiRules.h, SemiRules.cpp, Tokenizer.h, Tokenizer.cpp,
+*   Trace.h, Trace.cpp, LineIndex.h, LineIndex.cpp
+*
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.3 : 19 Oct 2026
+* - analyzeFile() catches Toker exceptions and marks the file unreadable
+* - lines come from Toker offsets and a LineIndex, so lines inside
+*   dropped block comments are no longer lost
+* - a SourceGuard restores the leased SemiExp's source even when get()
+*   throws
+* ver 1.2 : 19 Oct 2026
+* - optional latency tracing: the leased SemiExp reads through a
+*   TimedSource for the length of the file
+* ver 1.1 : 19 Oct 2026
+* - scans with Tokers leased from the thread's ScannerPool
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <iterator>
+#include <algorithm>
+#include <unordered_set>
+#include <thread>
+#include <atomic>
+#include <cctype>
+#include <stdexcept>
+#include "Analyzer.h"
+#include "../SemiExp/SemiExp.h"
+#include "../Tokenizer/Tokenizer.h"
+#include "../ScannerPool/ScannerPool.h"
+#include "../Trace/Trace.h"
+#include "../LineIndex/LineIndex.h"
+
+using namespace Scanner;
+
+namespace
+{
+  const std::unordered_set<std::string> controlWords = {
+    "if", "for", "while", "switch", "catch", "else", "do", "return", "sizeof"
+  };
+  const std::unordered_set<std::string> typeWords = {
+    "class", "struct", "union", "enum", "namespace"
+  };
+  const std::unordered_set<std::string> branchWords = {
+    "if", "for", "while", "case", "catch"
+  };
+
+  bool isName(const std::string& tok)
+  {
+    return std::isalpha(static_cast<unsigned char>(tok[0])) != 0;
+  }
+
+  //--Toker splits identifiers at '_', returning the underscores as punctuators
+  bool isUnderscores(const std::string& tok)
+  {
+    return tok.find_first_not_of('_') == std::string::npos;
+  }
+
+  bool isCode(const std::string& tok)
+  {
+    if (tok == "\n")
+      return false;
+    return !(tok.size() > 1 && tok[0] == '/' && (tok[1] == '/' || tok[1] == '*'));
+  }
+
+  //--counts branch keywords and &&, ||, ? in one token
+  size_t branchesIn(const std::string& tok)
+  {
+    if (branchWords.count(tok) > 0)
+      return 1;
+    if (!std::ispunct(static_cast<unsigned char>(tok[0])) || tok[0] == '"' || tok[0] == '\'')
+      return 0;
+    size_t count = 0;
+    for (size_t i = 0; i < tok.size(); ++i)
+    {
+      if (tok[i] == '?')
+        ++count;
+      else if (i + 1 < tok.size() && (tok[i] == '&' || tok[i] == '|') && tok[i + 1] == tok[i])
+      {
+        ++count;
+        ++i;
+      }
+    }
+    return count;
+  }
+
+  //--returns the qualified name of the function whose body semi opens,
+  //  or an empty string if semi opens some other kind of block
+  std::string functionName(SemiExp& semi)
+  {
+    std::vector<std::string> toks;
+    for (size_t i = 0; i < semi.length(); ++i)
+      if (isCode(semi[i]))
+        toks.push_back(semi[i]);
+    size_t open = toks.size();
+    int angles = 0, parens = 0;
+    for (size_t i = 0; i + 1 < toks.size(); ++i)
+    {
+      const std::string& tok = toks[i];
+      if (tok == "<") ++angles;
+      else if (tok == ">") --angles;
+      else if (tok == ">>") angles -= 2;
+      else if (tok == "(")
+      {
+        if (open == toks.size())
+          open = i;
+        ++parens;
+      }
+      else if (tok == ")") --parens;
+      else if (open == toks.size() && angles <= 0 && (typeWords.count(tok) > 0 || tok == "="))
+        return "";
+    }
+    if (open == 0 || open == toks.size() || parens != 0)
+      return "";
+    if (controlWords.count(toks[0]) > 0 || controlWords.count(toks[open - 1]) > 0)
+      return "";
+    size_t first = open - 1;
+    for (size_t i = 0; i < open; ++i)
+      if (toks[i] == "operator")
+        first = i;
+    if (first == open - 1 && !isName(toks[first]) && !isUnderscores(toks[first]))
+      return "";
+    while (first > 0)    // glue qualifiers, destructor '~' and '_' pieces
+    {
+      const std::string& prev = toks[first - 1];
+      bool glued = prev == "::" || prev == "~" || isUnderscores(prev);
+      if (!glued && isName(prev))
+        glued = toks[first] == "::" || isUnderscores(toks[first]);
+      if (!glued)
+        break;
+      --first;
+    }
+    std::string name;
+    for (size_t i = first; i < open; ++i)
+      name += toks[i];
+    return name;
+  }
+
+  struct OpenFunction
+  {
+    FunctionMetrics fm;
+    size_t depth;
+  };
+
+  //--points a pooled SemiExp back at its own Toker however the scope is
+  //  left, so a throw can't return it to the pool reading a dead source
+  class SourceGuard
+  {
+  public:
+    SourceGuard(SemiExp& semi, ITokSource* pSource) : _semi(semi), _pSource(pSource) {}
+    SourceGuard(const SourceGuard&) = delete;
+    SourceGuard& operator=(const SourceGuard&) = delete;
+    ~SourceGuard() { _semi.setSource(_pSource); }
+  private:
+    SemiExp& _semi;
+    ITokSource* _pSource;
+  };
+
+  //--keeps each thread's summary on its own cache line
+  struct alignas(64) ThreadSummary
+  {
+    TreeSummary sum;
+  };
+}
+
+//----< TreeSummary >------------------------------------------------
+
+TreeSummary::TreeSummary()
+  : files(0), unreadable(0), lines(0), functions(0), functionLines(0), branches(0), depth(0)
+{
+  longest = FunctionMetrics{ "", 0, 0, 0, 0 };
+  mostComplex = longest;
+}
+
+void TreeSummary::add(const FileMetrics& fm)
+{
+  if (!fm.readable)
+  {
+    ++unreadable;
+    return;
+  }
+  ++files;
+  lines += fm.lines;
+  depth = std::max(depth, fm.depth);
+  for (auto& fn : fm.functions)
+  {
+    ++functions;
+    functionLines += fn.lines;
+    branches += fn.branches;
+    if (fn.lines > longest.lines)
+    {
+      longest = fn;
+      longestFile = fm.file;
+    }
+    if (fn.branches > mostComplex.branches)
+    {
+      mostComplex = fn;
+      mostComplexFile = fm.file;
+    }
+  }
+}
+
+void TreeSummary::merge(const TreeSummary& other)
+{
+  files += other.files;
+  unreadable += other.unreadable;
+  lines += other.lines;
+  functions += other.functions;
+  functionLines += other.functionLines;
+  branches += other.branches;
+  depth = std::max(depth, other.depth);
+  if (other.longest.lines > longest.lines)
+  {
+    longest = other.longest;
+    longestFile = other.longestFile;
+  }
+  if (other.mostComplex.branches > mostComplex.branches)
+  {
+    mostComplex = other.mostComplex;
+    mostComplexFile = other.mostComplexFile;
+  }
+}
+
+//----< MetricsAnalyzer >--------------------------------------------
+
+//--reads the stream once into memory, for its LineIndex
+void MetricsAnalyzer::analyzeStream(std::istream& in, FileMetrics& fm) const
+{
+  std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  LineIndex lines;
+  lines.assign(text.data(), text.size());
+  std::istringstream copy(text);
+  analyze(copy, lines, fm);
+}
+
+//--brace lines come from the Toker's offsets, so lines inside dropped
+//  comments still count
+void MetricsAnalyzer::analyze(std::istream& in, const LineIndex& lines, FileMetrics& fm) const
+{
+  fm.readable = true;
+  fm.lines = 0;
+  fm.depth = 0;
+  fm.functions.clear();
+  ScannerPool::Lease scanner = ScannerPool::local().acquire(&in);
+  if (!scanner.attached())
+    return;
+  SemiExp& semi = scanner.semi();
+  TimedSource timed(&scanner.toker(), _pTrace);
+  SourceGuard guard(semi, &scanner.toker());
+  if (_pTrace != nullptr)
+    semi.setSource(&timed);
+  std::vector<OpenFunction> open;
+  size_t depth = 0;
+  bool more = true;
+  while (more)
+  {
+    if (_pTrace == nullptr)
+      more = semi.get();
+    else
+    {
+      uint64_t start = _pTrace->now();
+      more = semi.get();
+      _pTrace->record(Phase::Group, _pTrace->now() - start);
+    }
+    if (semi.length() == 0)
+      continue;
+    size_t line = lines.position(scanner.toker().tokOffset()).line;
+    if (!open.empty())
+      for (size_t i = 0; i < semi.length(); ++i)
+        open.back().fm.branches += branchesIn(semi[i]);
+
+    const std::string& last = semi[static_cast<int>(semi.length()) - 1];
+    if (last == "{")
+    {
+      ++depth;
+      fm.depth = std::max(fm.depth, depth);
+      std::string name = functionName(semi);
+      if (name.size() > 0)
+        open.push_back(OpenFunction{ FunctionMetrics{ name, line, 0, 1, 0 }, depth });
+      else if (!open.empty())
+        open.back().fm.depth = std::max(open.back().fm.depth, depth - open.back().depth + 1);
+    }
+    else if (last == "}" && depth > 0)
+    {
+      if (!open.empty() && open.back().depth == depth)
+      {
+        FunctionMetrics done = open.back().fm;
+        done.lines = line - done.line + 1;
+        open.pop_back();
+        if (!open.empty())
+          open.back().fm.depth = std::max(open.back().fm.depth, done.depth + depth - open.back().depth);
+        fm.functions.push_back(done);
+      }
+      --depth;
+    }
+  }
+  fm.lines = lines.lineCount();
+}
+
+FileMetrics MetricsAnalyzer::analyzeFile(const std::string& path) const
+{
+  TraceSpan fileSpan(_pTrace, Phase::File, path);
+  FileMetrics fm;
+  fm.file = path;
+  std::ifstream in;
+  {
+    TraceSpan openSpan(_pTrace, Phase::Open, path);
+    in.open(path, std::ios::binary);   // offsets must be byte offsets
+  }
+  fm.readable = false;
+  fm.lines = 0;
+  fm.depth = 0;
+  if (in.good())
+  {
+    try
+    {
+      analyze(in, LineIndex(path), fm);
+    }
+    catch (std::exception&)   // bytes the Toker can't classify, such as a BOM
+    {
+      fm.readable = false;
+      fm.lines = 0;
+      fm.depth = 0;
+      fm.functions.clear();
+    }
+  }
+  return fm;
+}
+
+//--analyzes files on nThreads threads, reducing into per-thread summaries
+TreeSummary MetricsAnalyzer::analyzeFiles(const std::vector<std::string>& files,
+  std::vector<FileMetrics>* pPerFile, size_t nThreads) const
+{
+  if (nThreads == 0)
+    nThreads = std::max(1u, std::thread::hardware_concurrency());
+  nThreads = std::max(size_t(1), std::min(nThreads, files.size()));
+  if (pPerFile != nullptr)
+    pPerFile->assign(files.size(), FileMetrics());
+
+  std::vector<ThreadSummary> partial(nThreads);
+  std::atomic<size_t> next(0);
+  auto worker = [&](size_t t) {
+    size_t i;
+    while ((i = next++) < files.size())
+    {
+      FileMetrics fm = analyzeFile(files[i]);
+      partial[t].sum.add(fm);
+      if (pPerFile != nullptr)
+        (*pPerFile)[i] = std::move(fm);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t t = 1; t < nThreads; ++t)
+    threads.push_back(std::thread(worker, t));
+  worker(0);
+  for (auto& thrd : threads)
+    thrd.join();
+
+  TreeSummary total;
+  for (auto& part : partial)
+    total.merge(part.sum);
+  return total;
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_ANALYZER
+
+int main()
+{
+  std::vector<std::string> files = {
+    "../Tokenizer/Tokenizer.cpp", "../SemiExp/SemiExp.cpp", "../TestExec/TestExec.cpp",
+    "../Analyzer/Analyzer.cpp", "../SemiExp/SemiExpTestFile.txt", "../Tokenizer/BomTestFile.txt"
+  };
+  MetricsAnalyzer analyzer;
+  TraceRecorder trace;
+  analyzer.setTrace(&trace);
+  std::vector<FileMetrics> perFile;
+  TreeSummary sum = analyzer.analyzeFiles(files, &perFile);
+
+  std::cout << "\n  <-----------Code Metrics------------> \n";
+  for (auto& fm : perFile)
+  {
+    if (!fm.readable)
+    {
+      std::cout << "\n  " << fm.file << ": unreadable";
+      continue;
+    }
+    std::cout << "\n  " << fm.file << ": " << fm.lines << " lines, depth " << fm.depth;
+    for (auto& fn : fm.functions)
+      std::cout << "\n    " << fn.name << " (line " << fn.line << "): " << fn.lines
+                << " lines, depth " << fn.depth << ", complexity " << fn.branches + 1;
+  }
+  std::cout << "\n\n  " << sum.files << " files, " << sum.lines << " lines, "
+            << sum.functions << " functions, " << sum.branches << " branches, "
+            << sum.unreadable << " unreadable";
+  std::cout << "\n  longest:      " << sum.longestFile << " " << sum.longest.name << " (" << sum.longest.lines << " lines)";
+  std::cout << "\n  most complex: " << sum.mostComplexFile << " " << sum.mostComplex.name
+            << " (complexity " << sum.mostComplex.branches + 1 << ")";
+  std::cout << "\n";
+  trace.report(std::cout);
+  std::cout << "\n\n";
+  return 0;
+}
+#endif
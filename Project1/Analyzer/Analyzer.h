@@ -0,0 +1,129 @@
+#ifndef ANALYZER_H
+#define ANALYZER_H
+///////////////////////////////////////////////////////////////////////
+// Analyzer.h - per-function code metrics from SemiExp streams       //
+// ver 1.3                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package provides a public MetricsAnalyzer class that reads the
+* semi-expressions of each file and reports, for every function:
+*   - its line count, from the line of its opening brace to the line
+*     of the matching closing brace
+*   - the deepest brace nesting inside its body
+*   - its branch count: if, for, while, case, catch, &&, || and ?
+*     (cyclomatic complexity is branches + 1)
+* A semi-expression ending in '{' opens a function when it holds a name
+* followed by '(' and does not start with a control keyword or a type
+* keyword such as class, struct or namespace.  Lines are found from the
+* Toker's token offsets with a LineIndex; analyzeStream() reads its
+* stream into memory first to build one.
+*
+* analyzeFiles() runs files on several threads.  Each thread folds its
+* files into its own TreeSummary; the summaries are merged once all
+* threads have joined, so no lock is taken while analyzing.
+*
+* A file that can't be opened, or holds bytes the Toker rejects such as
+* a UTF-8 byte order mark, comes back with readable false and no
+* metrics, and is counted in TreeSummary::unreadable instead of files.
+*
+* Given a TraceRecorder, the analyzer records the latency of opening
+* each file, of each getTok() and SemiExp::get(), and of each file as a
+* whole, with a trace span per file.
+*
+* Public Interface:
+* -----------------
+* MetricsAnalyzer analyzer;
+* FileMetrics fm = analyzer.analyzeFile("Tokenizer.cpp");
+* TreeSummary sum = analyzer.analyzeFiles(files, &perFile);
+* analyzer.setTrace(&trace);     // optional, before analyzing
+*
+* Build Process:
+* --------------
+* Required Files:
+*   Analyzer.h, Analyzer.cpp, ScannerPool.h, ScannerPool.cpp, SemiExp.h,
+*   SemiExp.cpp, SemiRules.h, SemiRules.cpp, Tokenizer.h, Tokenizer.cpp,
+*   Trace.h, Trace.cpp, LineIndex.h, LineIndex.cpp
+*
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.3 : 19 Oct 2026
+* - files the Toker throws on are reported as unreadable instead of
+*   ending the process from a worker thread
+* - function and file line counts come from a LineIndex and include
+*   lines inside block comments
+* ver 1.2 : 19 Oct 2026
+* - setTrace() records open, scan, group and per-file latencies
+* ver 1.1 : 19 Oct 2026
+* - per-file Tokers come from ScannerPool
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+
+#include <string>
+#include <vector>
+#include <iosfwd>
+
+namespace Scanner
+{
+  class TraceRecorder;
+  class LineIndex;
+
+  struct FunctionMetrics
+  {
+    std::string name;
+    size_t line;       // line of the opening brace
+    size_t lines;
+    size_t depth;      // deepest nesting inside the body, body itself is 1
+    size_t branches;
+  };
+
+  struct FileMetrics
+  {
+    std::string file;
+    bool readable;     // false if it couldn't be opened or tokenized
+    size_t lines;
+    size_t depth;
+    std::vector<FunctionMetrics> functions;
+  };
+
+  struct TreeSummary
+  {
+    TreeSummary();
+    void add(const FileMetrics& fm);
+    void merge(const TreeSummary& other);
+    size_t files;
+    size_t unreadable;
+    size_t lines;
+    size_t functions;
+    size_t functionLines;
+    size_t branches;
+    size_t depth;
+    FunctionMetrics longest;     // most lines
+    FunctionMetrics mostComplex; // most branches
+    std::string longestFile;
+    std::string mostComplexFile;
+  };
+
+  class MetricsAnalyzer
+  {
+  public:
+    MetricsAnalyzer() : _pTrace(nullptr) {}
+    void setTrace(TraceRecorder* pTrace) { _pTrace = pTrace; }
+    void analyzeStream(std::istream& in, FileMetrics& fm) const;
+    FileMetrics analyzeFile(const std::string& path) const;
+    TreeSummary analyzeFiles(const std::vector<std::string>& files,
+      std::vector<FileMetrics>* pPerFile = nullptr, size_t nThreads = 0) const;
+  private:
+    void analyze(std::istream& in, const LineIndex& lines, FileMetrics& fm) const;
+    TraceRecorder* _pTrace;
+  };
+}
+#endif
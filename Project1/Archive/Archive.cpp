@@ -0,0 +1,587 @@
+///////////////////////////////////////////////////////////////////////
+// Archive.cpp - tokenize files inside compressed tarballs in one pass //
+// ver 1.1                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* The producer thread owns the FILE and the decompressor.  It fills one
+* block at a time and hands it over with push(), which waits while
+* maxBlocks blocks are queued.  underflow() returns the block it just
+* finished to a free list, so after start-up no block is allocated again.
+* A gzip file made of several concatenated members, as pigz and some
+* log rotators write, is decoded as one stream.
+*
+* Tar headers are checked against their checksum; a header that fails
+* ends the walk as if the archive ended there.
+*
+* Build Process:
+* --------------
+* Required Files: Archive.h, Archive.cpp, Tokenizer.h, Tokenizer.cpp
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 19 Oct 2026
+* - at the end of a zstd input, produce() keeps draining the decoder
+*   while its last call filled the block, instead of failing the stream
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+#include <cstring>
+#include <algorithm>
+#include "Archive.h"
+#ifdef ARCHIVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef ARCHIVE_ZSTD
+#include <zstd.h>
+#endif
+
+using namespace Scanner;
+
+namespace
+{
+  const size_t ReadSize = 64 * 1024;
+
+  //--kind of file from its first bytes
+  Compression detect(std::FILE* pFile)
+  {
+    unsigned char magic[4] = { 0, 0, 0, 0 };
+    size_t n = std::fread(magic, 1, 4, pFile);
+    std::rewind(pFile);
+    if (n >= 2 && magic[0] == 0x1f && magic[1] == 0x8b)
+      return Compression::Gzip;
+    if (n == 4 && magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f && magic[3] == 0xfd)
+      return Compression::Zstd;
+    return Compression::None;
+  }
+
+  bool supported(Compression kind)
+  {
+#ifndef ARCHIVE_ZLIB
+    if (kind == Compression::Gzip)
+      return false;
+#endif
+#ifndef ARCHIVE_ZSTD
+    if (kind == Compression::Zstd)
+      return false;
+#endif
+    return true;
+  }
+}
+
+//----< decompressing stream buffer >--------------------------------
+
+DecompressBuf::DecompressBuf(size_t blockSize, size_t maxBlocks)
+  : _blockSize(std::max<size_t>(blockSize, 1)), _maxBlocks(std::max<size_t>(maxBlocks, 1)),
+    _done(true), _stop(false), _failed(false) {}
+
+DecompressBuf::~DecompressBuf()
+{
+  close();
+}
+
+bool DecompressBuf::open(const std::string& path, Compression kind)
+{
+  close();
+  std::FILE* pFile = std::fopen(path.c_str(), "rb");
+  if (pFile == nullptr)
+    return false;
+  if (kind == Compression::Detect)
+    kind = detect(pFile);
+  if (!supported(kind))
+  {
+    std::fclose(pFile);
+    return false;
+  }
+  _done = _stop = _failed = false;
+  _producer = std::thread(&DecompressBuf::produce, this, pFile, kind);
+  return true;
+}
+
+void DecompressBuf::close()
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stop = true;
+  }
+  _changed.notify_all();
+  if (_producer.joinable())
+    _producer.join();
+  while (!_full.empty())
+  {
+    _free.push_back(std::move(_full.front()));
+    _full.pop_front();
+  }
+  _current.clear();
+  setg(nullptr, nullptr, nullptr);
+  _done = true;
+}
+
+bool DecompressBuf::failed() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _failed;
+}
+
+//--queues a filled block and gives back an empty one; false if closing
+bool DecompressBuf::push(std::vector<char>& block)
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+  _changed.wait(lock, [this]() { return _stop || _full.size() < _maxBlocks; });
+  if (_stop)
+    return false;
+  _full.push_back(std::move(block));
+  if (_free.empty())
+    block = std::vector<char>();
+  else
+  {
+    block = std::move(_free.back());
+    _free.pop_back();
+  }
+  lock.unlock();
+  _changed.notify_all();
+  block.resize(_blockSize);
+  return true;
+}
+
+//--runs on the producer thread until the input ends or close() is called
+void DecompressBuf::produce(std::FILE* pFile, Compression kind)
+{
+  std::vector<char> block(_blockSize);
+  size_t used = 0;
+  bool ok = true;
+  bool live = true;
+  auto emit = [&]() -> bool {
+    block.resize(used);
+    used = 0;
+    return push(block);
+  };
+
+  if (kind == Compression::None)
+  {
+    while (live)
+    {
+      used = std::fread(block.data(), 1, _blockSize, pFile);
+      if (used == 0)
+        break;
+      live = emit();
+    }
+    ok = std::ferror(pFile) == 0;
+  }
+#ifdef ARCHIVE_ZLIB
+  else if (kind == Compression::Gzip)
+  {
+    std::vector<unsigned char> input(ReadSize);
+    z_stream zs;
+    std::memset(&zs, 0, sizeof(zs));
+    ok = inflateInit2(&zs, 15 + 32) == Z_OK;   // +32: gzip or zlib header
+    bool ended = false;
+    while (ok && live)
+    {
+      if (zs.avail_in == 0)
+      {
+        zs.avail_in = static_cast<uInt>(std::fread(input.data(), 1, input.size(), pFile));
+        zs.next_in = input.data();
+        if (zs.avail_in == 0)
+        {
+          ok = ended && std::ferror(pFile) == 0;   // truncated if inside a member
+          break;
+        }
+      }
+      zs.next_out = reinterpret_cast<Bytef*>(block.data() + used);
+      zs.avail_out = static_cast<uInt>(_blockSize - used);
+      int rc = inflate(&zs, Z_NO_FLUSH);
+      used = _blockSize - zs.avail_out;
+      ended = false;
+      if (rc == Z_STREAM_END)
+      {
+        ended = true;
+        inflateReset(&zs);       // another member may follow
+      }
+      else if (rc != Z_OK && rc != Z_BUF_ERROR)
+        ok = false;
+      if (used == _blockSize)
+        live = emit();
+    }
+    inflateEnd(&zs);
+    if (ok && live && used > 0)
+      live = emit();
+  }
+#endif
+#ifdef ARCHIVE_ZSTD
+  else if (kind == Compression::Zstd)
+  {
+    std::vector<char> input(ReadSize);
+    ZSTD_DStream* pZs = ZSTD_createDStream();
+    ok = pZs != nullptr && !ZSTD_isError(ZSTD_initDStream(pZs));
+    ZSTD_inBuffer in = { input.data(), 0, 0 };
+    size_t hint = 0;
+    bool full = false;   // the last call filled the block
+    while (ok && live)
+    {
+      if (in.pos == in.size)
+      {
+        in.size = std::fread(input.data(), 1, input.size(), pFile);
+        in.pos = 0;
+        if (in.size == 0 && (!full || hint == 0))   // else the decoder may hold more
+        {
+          ok = hint == 0 && std::ferror(pFile) == 0;   // nonzero hint: frame unfinished
+          break;
+        }
+      }
+      ZSTD_outBuffer out = { block.data(), _blockSize, used };
+      hint = ZSTD_decompressStream(pZs, &out, &in);
+      used = out.pos;
+      full = used == _blockSize;
+      if (ZSTD_isError(hint))
+        ok = false;
+      if (full)
+        live = emit();
+    }
+    ZSTD_freeDStream(pZs);
+    if (ok && live && used > 0)
+      live = emit();
+  }
+#endif
+  std::fclose(pFile);
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _done = true;
+    _failed = !ok;
+  }
+  _changed.notify_all();
+}
+
+//--hands the finished block back and takes the next one
+DecompressBuf::int_type DecompressBuf::underflow()
+{
+  if (gptr() < egptr())
+    return traits_type::to_int_type(*gptr());
+  std::unique_lock<std::mutex> lock(_mutex);
+  if (_current.capacity() > 0)
+  {
+    _free.push_back(std::move(_current));
+    _current = std::vector<char>();
+  }
+  _changed.wait(lock, [this]() { return _done || !_full.empty(); });
+  if (_full.empty())
+  {
+    setg(nullptr, nullptr, nullptr);
+    return traits_type::eof();
+  }
+  _current = std::move(_full.front());
+  _full.pop_front();
+  lock.unlock();
+  _changed.notify_all();
+  setg(_current.data(), _current.data(), _current.data() + _current.size());
+  return traits_type::to_int_type(*gptr());
+}
+
+bool DecompressStream::open(const std::string& path, Compression kind)
+{
+  clear();
+  if (_buf.open(path, kind))
+    return true;
+  setstate(std::ios::failbit);
+  return false;
+}
+
+//----< tar entries >------------------------------------------------
+
+namespace
+{
+  //--a NUL-terminated or full-width header field
+  std::string field(const char* block, size_t offset, size_t width)
+  {
+    const char* start = block + offset;
+    return std::string(start, std::find(start, start + width, '\0'));
+  }
+
+  //--octal, or base-256 when the top bit of the first byte is set
+  bool number(const char* block, size_t offset, size_t width, size_t& value)
+  {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(block + offset);
+    value = 0;
+    if (p[0] & 0x80)
+    {
+      for (size_t i = 1; i < width; ++i)
+        value = (value << 8) | p[i];
+      return (p[0] & 0x7f) == 0;
+    }
+    size_t i = 0;
+    while (i < width && p[i] == ' ')
+      ++i;
+    for (; i < width && p[i] >= '0' && p[i] <= '7'; ++i)
+      value = value * 8 + (p[i] - '0');
+    return true;
+  }
+
+  bool checksumOk(const char* block)
+  {
+    size_t stored;
+    if (!number(block, 148, 8, stored))
+      return false;
+    size_t sum = 0;
+    for (size_t i = 0; i < 512; ++i)
+      sum += (i >= 148 && i < 156) ? ' ' : static_cast<unsigned char>(block[i]);
+    return sum == stored;
+  }
+
+  //--value of "path" in a pax extended header, or ""
+  std::string paxPath(const std::string& records)
+  {
+    size_t pos = 0;
+    std::string path;
+    while (pos < records.size())
+    {
+      size_t space = records.find(' ', pos);
+      if (space == std::string::npos)
+        break;
+      size_t length = std::strtoul(records.c_str() + pos, nullptr, 10);
+      if (length == 0 || pos + length > records.size())
+        break;
+      std::string record = records.substr(space + 1, pos + length - space - 2);   // drop '\n'
+      if (record.compare(0, 5, "path=") == 0)
+        path = record.substr(5);
+      pos += length;
+    }
+    return path;
+  }
+}
+
+void TarReader::EntryBuf::start(size_t size)
+{
+  _remaining = size;
+  setg(nullptr, nullptr, nullptr);
+}
+
+bool TarReader::EntryBuf::skip()
+{
+  setg(nullptr, nullptr, nullptr);
+  if (_remaining > 0)
+    _in.ignore(static_cast<std::streamsize>(_remaining));
+  _remaining = 0;
+  return _in.good();
+}
+
+TarReader::EntryBuf::int_type TarReader::EntryBuf::underflow()
+{
+  if (gptr() < egptr())
+    return traits_type::to_int_type(*gptr());
+  if (_remaining == 0)
+    return traits_type::eof();
+  size_t want = std::min(_remaining, _buffer.size());
+  _in.read(_buffer.data(), static_cast<std::streamsize>(want));
+  size_t got = static_cast<size_t>(_in.gcount());
+  if (got == 0)
+  {
+    _remaining = 0;
+    return traits_type::eof();
+  }
+  _remaining -= got;
+  setg(_buffer.data(), _buffer.data(), _buffer.data() + got);
+  return traits_type::to_int_type(*gptr());
+}
+
+TarReader::TarReader(std::istream& in)
+  : _in(in), _entryBuf(in), _body(&_entryBuf), _padding(0) {}
+
+bool TarReader::readBlock(char* block)
+{
+  _in.read(block, 512);
+  return _in.gcount() == 512;
+}
+
+//--reads a metadata body and its padding
+bool TarReader::readBody(size_t size, std::string& text)
+{
+  text.resize(size);
+  if (size > 0)
+    _in.read(&text[0], static_cast<std::streamsize>(size));
+  if (static_cast<size_t>(_in.gcount()) != size)
+    return false;
+  _in.ignore(static_cast<std::streamsize>((512 - size % 512) % 512));
+  return _in.good();
+}
+
+//--moves to the next entry, skipping what is left of the current one
+bool TarReader::next(TarEntry& entry)
+{
+  if (!_entryBuf.skip())
+    return false;
+  if (_padding > 0)
+    _in.ignore(static_cast<std::streamsize>(_padding));
+  _padding = 0;
+
+  std::string longName;
+  char block[512];
+  while (readBlock(block))
+  {
+    if (std::all_of(block, block + 512, [](char ch) { return ch == '\0'; }))
+      return false;
+    if (!checksumOk(block))
+      return false;
+    size_t size;
+    if (!number(block, 124, 12, size))
+      return false;
+    char type = block[156];
+    if (type == 'L' || type == 'x' || type == 'g')
+    {
+      std::string text;
+      if (!readBody(size, text))
+        return false;
+      if (type == 'L')
+        longName = field(text.c_str(), 0, text.size());
+      else if (type == 'x')
+      {
+        std::string path = paxPath(text);
+        if (path != "")
+          longName = path;
+      }
+      continue;
+    }
+    if (type == '1' || type == '2' || type == '3' || type == '4' || type == '5' || type == '6')
+      size = 0;   // links, devices, directories and fifos have no data
+    entry.type = type;
+    entry.size = size;
+    if (longName != "")
+      entry.name = longName;
+    else
+    {
+      std::string prefix = std::memcmp(block + 257, "ustar", 5) == 0 ? field(block, 345, 155) : "";
+      entry.name = prefix == "" ? field(block, 0, 100) : prefix + "/" + field(block, 0, 100);
+    }
+    _entryBuf.start(size);
+    _padding = (512 - size % 512) % 512;
+    _body.clear();
+    return true;
+  }
+  return false;
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_ARCHIVE
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include "../Tokenizer/Tokenizer.h"
+
+namespace
+{
+  //--a minimal ustar header
+  std::string header(const std::string& name, size_t size)
+  {
+    char block[512];
+    std::memset(block, 0, sizeof(block));
+    std::strncpy(block, name.c_str(), 99);
+    std::sprintf(block + 100, "%07o", 0644);
+    std::sprintf(block + 108, "%07o", 0);
+    std::sprintf(block + 116, "%07o", 0);
+    std::sprintf(block + 124, "%011o", static_cast<unsigned>(size));
+    std::sprintf(block + 136, "%011o", 0);
+    block[156] = '0';
+    std::memcpy(block + 257, "ustar", 6);
+    std::memcpy(block + 263, "00", 2);
+    std::memset(block + 148, ' ', 8);
+    unsigned sum = 0;
+    for (size_t i = 0; i < 512; ++i)
+      sum += static_cast<unsigned char>(block[i]);
+    std::sprintf(block + 148, "%06o", sum);
+    return std::string(block, 512);
+  }
+
+  size_t countTokens(std::istream& in)
+  {
+    Scanner::Toker toker;
+    toker.attach(&in);
+    size_t count = 0;
+    while (toker.getTok() != "")
+      ++count;
+    return count;
+  }
+}
+
+int main()
+{
+  std::cout << "\n  <-----------Tokenizing Inside an Archive------------> \n";
+  std::vector<std::string> files = {
+    "../Tokenizer/Tokenizer.h", "../Tokenizer/Tokenizer.cpp",
+    "../SemiExp/SemiExp.h", "../SemiExp/SemiExp.cpp"
+  };
+
+  std::string tar;
+  std::vector<size_t> direct;
+  for (auto& file : files)
+  {
+    std::ifstream in(file, std::ios::binary);
+    std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    tar += header(file.substr(3), text.size()) + text + std::string((512 - text.size() % 512) % 512, '\0');
+    std::istringstream textIn(text);
+    direct.push_back(countTokens(textIn));
+  }
+  tar += std::string(1024, '\0');
+
+  std::string path = "archive_test.tar";
+  std::ofstream(path, std::ios::binary) << tar;
+#ifdef ARCHIVE_ZLIB
+  std::string gzPath = path + ".gz";
+  gzFile gz = gzopen(gzPath.c_str(), "wb");
+  gzwrite(gz, tar.data(), static_cast<unsigned>(tar.size() / 2));
+  gzclose(gz);
+  gz = gzopen(gzPath.c_str(), "ab");     // a second member, as pigz writes
+  gzwrite(gz, tar.data() + tar.size() / 2, static_cast<unsigned>(tar.size() - tar.size() / 2));
+  gzclose(gz);
+  std::vector<std::string> archives = { path, gzPath };
+#else
+  std::vector<std::string> archives = { path };
+#endif
+#ifdef ARCHIVE_ZSTD
+  std::string zstPath = path + ".zst";
+  {
+    std::ofstream zst(zstPath, std::ios::binary);
+    for (size_t half = 0; half < 2; ++half)   // two frames, as zstd -c a b writes
+    {
+      size_t from = half * (tar.size() / 2), size = half == 0 ? tar.size() / 2 : tar.size() - from;
+      std::vector<char> frame(ZSTD_compressBound(size));
+      frame.resize(ZSTD_compress(frame.data(), frame.size(), tar.data() + from, size, 3));
+      zst.write(frame.data(), frame.size());
+    }
+  }
+  archives.push_back(zstPath);
+#endif
+
+  for (auto& archive : archives)
+  {
+    Scanner::DecompressStream in;
+    if (!in.open(archive))
+    {
+      std::cout << "\n  can't open " << archive;
+      continue;
+    }
+    Scanner::TarReader reader(in);
+    Scanner::TarEntry entry;
+    size_t i = 0;
+    std::cout << "\n  " << archive;
+    while (reader.next(entry))
+    {
+      size_t count = countTokens(reader.body());
+      std::cout << "\n    " << entry.name << ": " << count << " tokens, "
+                << (i < direct.size() && count == direct[i] ? "same as direct read" : "DIFFERENT");
+      ++i;
+    }
+    if (in.failed())
+      std::cout << "\n    decompression failed";
+    std::remove(archive.c_str());
+  }
+  std::cout << "\n\n";
+  return 0;
+}
+#endif
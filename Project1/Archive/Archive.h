@@ -0,0 +1,143 @@
+#ifndef ARCHIVE_H
+#define ARCHIVE_H
+///////////////////////////////////////////////////////////////////////
+// Archive.h - tokenize files inside compressed tarballs in one pass //
+// ver 1.0                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package lets Toker read source files straight out of a compressed
+* tarball, without unpacking anything to disk.
+*
+* DecompressStream is a std::istream whose bytes are produced by a
+* separate thread: it reads the compressed file, decompresses it into
+* fixed-size blocks and queues them, blocking when a small number of
+* blocks is waiting.  The reader only swaps blocks, so decompression
+* overlaps with tokenizing and memory stays bounded by the block count.
+*
+* TarReader walks the entries of a tar stream in order.  body() is an
+* istream over the current entry alone, so it can be handed directly to
+* Toker::attach; next() skips whatever of it was not read.  ustar name
+* prefixes, GNU long names and pax path records are understood.
+*
+* Public Interface:
+* -----------------
+* DecompressStream in;
+* in.open("snapshot.tar.gz");
+* TarReader tar(in);
+* TarEntry entry;
+* while (tar.next(entry))
+*   if (entry.isFile()) { Toker toker; toker.attach(&tar.body()); ... }
+*
+* Build Process:
+* --------------
+* Required Files: Archive.h, Archive.cpp
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Uncompressed input always works.  Define ARCHIVE_ZLIB and link zlib for
+* gzip, and ARCHIVE_ZSTD and link libzstd for zstd; without them open()
+* returns false for that kind of file.
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <istream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+
+namespace Scanner
+{
+  enum class Compression { Detect, None, Gzip, Zstd };
+
+  class DecompressBuf : public std::streambuf
+  {
+  public:
+    DecompressBuf(size_t blockSize = 256 * 1024, size_t maxBlocks = 4);
+    DecompressBuf(const DecompressBuf&) = delete;
+    DecompressBuf& operator=(const DecompressBuf&) = delete;
+    ~DecompressBuf();
+    bool open(const std::string& path, Compression kind = Compression::Detect);
+    void close();
+    bool failed() const;   //true if the input was corrupt or truncated
+  protected:
+    virtual int_type underflow();
+  private:
+    void produce(std::FILE* pFile, Compression kind);
+    bool push(std::vector<char>& block);
+    std::thread _producer;
+    mutable std::mutex _mutex;
+    std::condition_variable _changed;
+    std::deque<std::vector<char>> _full;
+    std::vector<std::vector<char>> _free;
+    std::vector<char> _current;
+    size_t _blockSize;
+    size_t _maxBlocks;
+    bool _done;
+    bool _stop;
+    bool _failed;
+  };
+
+  class DecompressStream : public std::istream
+  {
+  public:
+    DecompressStream() : std::istream(&_buf) {}
+    bool open(const std::string& path, Compression kind = Compression::Detect);
+    void close() { _buf.close(); }
+    bool failed() const { return _buf.failed(); }
+  private:
+    DecompressBuf _buf;
+  };
+
+  struct TarEntry
+  {
+    std::string name;
+    size_t size;
+    char type;       // '0' file, '5' directory, ...
+    bool isFile() const { return type == '0' || type == '\0'; }
+  };
+
+  class TarReader
+  {
+  public:
+    explicit TarReader(std::istream& in);
+    TarReader(const TarReader&) = delete;
+    TarReader& operator=(const TarReader&) = delete;
+    bool next(TarEntry& entry);   //false at end of archive or on a bad header
+    std::istream& body() { return _body; }
+  private:
+    class EntryBuf : public std::streambuf
+    {
+    public:
+      EntryBuf(std::istream& in) : _in(in), _remaining(0), _buffer(64 * 1024) {}
+      void start(size_t size);
+      bool skip();     // discards the rest of the entry
+    protected:
+      virtual int_type underflow();
+    private:
+      std::istream& _in;
+      size_t _remaining;
+      std::vector<char> _buffer;
+    };
+    bool readBlock(char* block);
+    bool readBody(size_t size, std::string& text);
+    std::istream& _in;
+    EntryBuf _entryBuf;
+    std::istream _body;
+    size_t _padding;
+  };
+}
+#endif
@@ -0,0 +1,622 @@
+///////////////////////////////////////////////////////////////////////
+// Bench.cpp - throughput and allocation benchmark for Toker/SemiExp //
+// ver 1.1                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* The counting operator new puts the block size in a 16 byte header in
+* front of each block, so operator delete knows how many bytes go.  Live
+* bytes are tracked at all times, since blocks made before start() may
+* be freed after it; totals and the peak only while counting.
+*
+* Each hardware counter is its own perf event, opened disabled, for the
+* calling thread on any CPU, user mode only, so it works at the default
+* perf_event_paranoid of 2.  The time enabled and running are read with
+* each count, to scale counts the kernel multiplexed.
+*
+* Build Process:
+* --------------
+* Required Files:
+*   Bench.h, Bench.cpp, SemiExp.h, SemiExp.cpp, SemiRules.h,
+*   SemiRules.cpp, Tokenizer.h, Tokenizer.cpp
+*
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 19 Oct 2026
+* - added HwCounters, on perf_event_open where the platform has it
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <map>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <new>
+#include "Bench.h"
+#include "../Tokenizer/Tokenizer.h"
+#include "../SemiExp/SemiExp.h"
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace Scanner;
+
+//----< allocation counting >----------------------------------------
+
+namespace
+{
+  std::atomic<bool> counting(false);
+  std::atomic<uint64_t> allocations(0);
+  std::atomic<uint64_t> frees(0);
+  std::atomic<uint64_t> bytes(0);
+  std::atomic<int64_t> live(0);
+  std::atomic<int64_t> peak(0);
+  int64_t liveAtStart = 0;
+}
+
+#ifdef BENCH_COUNT_ALLOCS
+
+namespace
+{
+  const size_t Header = 16;
+
+  void* countedNew(size_t size)
+  {
+    char* raw = static_cast<char*>(std::malloc(size + Header));
+    if (raw == nullptr)
+      return nullptr;
+    *reinterpret_cast<size_t*>(raw) = size;
+    int64_t now = live += static_cast<int64_t>(size);
+    if (counting.load(std::memory_order_relaxed))
+    {
+      ++allocations;
+      bytes += size;
+      int64_t high = peak.load(std::memory_order_relaxed);
+      while (now > high && !peak.compare_exchange_weak(high, now))
+        ;
+    }
+    return raw + Header;
+  }
+
+  void countedDelete(void* p)
+  {
+    if (p == nullptr)
+      return;
+    char* raw = static_cast<char*>(p) - Header;
+    live -= static_cast<int64_t>(*reinterpret_cast<size_t*>(raw));
+    if (counting.load(std::memory_order_relaxed))
+      ++frees;
+    std::free(raw);
+  }
+}
+
+void* operator new(size_t size)
+{
+  void* p = countedNew(size);
+  if (p == nullptr)
+    throw std::bad_alloc();
+  return p;
+}
+
+void* operator new[](size_t size)
+{
+  return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+  return countedNew(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+  return countedNew(size);
+}
+
+void operator delete(void* p) noexcept { countedDelete(p); }
+void operator delete[](void* p) noexcept { countedDelete(p); }
+void operator delete(void* p, size_t) noexcept { countedDelete(p); }
+void operator delete[](void* p, size_t) noexcept { countedDelete(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { countedDelete(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { countedDelete(p); }
+
+bool AllocCounter::available() { return true; }
+
+#else
+
+bool AllocCounter::available() { return false; }
+
+#endif
+
+void AllocCounter::start()
+{
+  allocations = frees = bytes = 0;
+  liveAtStart = live;
+  peak = liveAtStart;
+  counting = true;
+}
+
+AllocStats AllocCounter::stop()
+{
+  counting = false;
+  int64_t high = peak - liveAtStart;
+  return AllocStats{ allocations, frees, bytes, static_cast<uint64_t>(high > 0 ? high : 0) };
+}
+
+size_t Scanner::peakRss()
+{
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS counters;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    return counters.PeakWorkingSetSize;
+  return 0;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+#ifdef __APPLE__
+  return static_cast<size_t>(usage.ru_maxrss);          // bytes
+#else
+  return static_cast<size_t>(usage.ru_maxrss) * 1024;   // kilobytes
+#endif
+#endif
+}
+
+//----< hardware counters >-----------------------------------------
+
+bool HwStats::any() const
+{
+  for (int e = 0; e < HwEvents; ++e)
+    if (counted[e])
+      return true;
+  return false;
+}
+
+const char* HwCounters::name(HwEvent event)
+{
+  static const char* names[HwEvents] = {
+    "cycles", "instructions", "branches", "branch misses", "L1d read misses", "LLC misses"
+  };
+  return names[event];
+}
+
+HwCounters::HwCounters()
+{
+  for (int e = 0; e < HwEvents; ++e)
+    _fds[e] = -1;
+}
+
+#ifdef __linux__
+
+namespace
+{
+  struct HwRead
+  {
+    uint64_t value;
+    uint64_t enabled;   // PERF_FORMAT_TOTAL_TIME_ENABLED
+    uint64_t running;   // PERF_FORMAT_TOTAL_TIME_RUNNING
+  };
+
+  perf_event_attr eventAttr(HwEvent event)
+  {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    switch (event)
+    {
+    case Cycles:       attr.config = PERF_COUNT_HW_CPU_CYCLES; break;
+    case Instructions: attr.config = PERF_COUNT_HW_INSTRUCTIONS; break;
+    case Branches:     attr.config = PERF_COUNT_HW_BRANCH_INSTRUCTIONS; break;
+    case BranchMisses: attr.config = PERF_COUNT_HW_BRANCH_MISSES; break;
+    case LlcMisses:    attr.config = PERF_COUNT_HW_CACHE_MISSES; break;
+    default:
+      attr.type = PERF_TYPE_HW_CACHE;
+      attr.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+        (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    }
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return attr;
+  }
+}
+
+HwCounters::~HwCounters()
+{
+  for (int e = 0; e < HwEvents; ++e)
+    if (_fds[e] >= 0)
+      close(_fds[e]);
+}
+
+bool HwCounters::open()
+{
+  bool any = false;
+  _error.clear();
+  for (int e = 0; e < HwEvents; ++e)
+  {
+    if (_fds[e] < 0)
+    {
+      perf_event_attr attr = eventAttr(HwEvent(e));
+      _fds[e] = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+      if (_fds[e] < 0 && _error.empty())
+      {
+        _error = std::string("perf_event_open: ") + std::strerror(errno);
+        if (errno == ENOENT || errno == EOPNOTSUPP)
+          _error += " (no PMU, as in many VMs and containers)";
+        else if (errno == EACCES || errno == EPERM)
+          _error += " (see /proc/sys/kernel/perf_event_paranoid)";
+      }
+    }
+    any = any || _fds[e] >= 0;
+  }
+  return any;
+}
+
+void HwCounters::start()
+{
+  for (int e = 0; e < HwEvents; ++e)
+    if (_fds[e] >= 0)
+    {
+      ioctl(_fds[e], PERF_EVENT_IOC_RESET, 0);
+      ioctl(_fds[e], PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+HwStats HwCounters::stop()
+{
+  HwStats stats = HwStats();
+  stats.error = _error;
+  for (int e = 0; e < HwEvents; ++e)
+  {
+    if (_fds[e] < 0)
+      continue;
+    ioctl(_fds[e], PERF_EVENT_IOC_DISABLE, 0);
+    HwRead sample = HwRead();
+    if (read(_fds[e], &sample, sizeof(sample)) != sizeof(sample) || sample.running == 0)
+    {
+      if (stats.error.empty())
+        stats.error = std::string(name(HwEvent(e))) + " never ran";
+      continue;
+    }
+    double scale = sample.running < sample.enabled ? double(sample.enabled) / sample.running : 1.0;
+    stats.counts[e] = static_cast<uint64_t>(sample.value * scale);
+    stats.counted[e] = true;
+  }
+  return stats;
+}
+
+#else
+
+HwCounters::~HwCounters() {}
+
+bool HwCounters::open()
+{
+  _error = "hardware counters need Linux perf_event_open";
+  return false;
+}
+
+void HwCounters::start() {}
+
+HwStats HwCounters::stop()
+{
+  HwStats stats = HwStats();
+  stats.error = _error;
+  return stats;
+}
+
+#endif
+
+//----< benchmark >--------------------------------------------------
+
+namespace
+{
+  //--reads a string in place, so the benchmark doesn't count a copy
+  class TextBuf : public std::streambuf
+  {
+  public:
+    TextBuf(const std::string& text)
+    {
+      char* p = const_cast<char*>(text.data());
+      setg(p, p, p + text.size());
+    }
+  };
+
+  const double MB = 1024.0 * 1024.0;
+}
+
+double BenchResult::allocsPerToken() const
+{
+  return tokens > 0 ? double(allocs.allocations) / (double(tokens) * repeat) : 0.0;
+}
+
+double BenchResult::allocsPerMB() const
+{
+  return inputBytes > 0 ? allocs.allocations / (inputBytes * double(repeat) / MB) : 0.0;
+}
+
+double BenchResult::allocBytesPerMB() const
+{
+  return inputBytes > 0 ? allocs.bytes / (inputBytes * double(repeat) / MB) : 0.0;
+}
+
+double BenchResult::mbPerSecond() const
+{
+  return seconds > 0 ? inputBytes * double(repeat) / MB / seconds : 0.0;
+}
+
+double BenchResult::instructionsPerCycle() const
+{
+  if (!hw.counted[Cycles] || !hw.counted[Instructions] || hw.counts[Cycles] == 0)
+    return 0.0;
+  return double(hw.counts[Instructions]) / hw.counts[Cycles];
+}
+
+double BenchResult::branchMissRate() const
+{
+  if (!hw.counted[Branches] || !hw.counted[BranchMisses] || hw.counts[Branches] == 0)
+    return 0.0;
+  return double(hw.counts[BranchMisses]) / hw.counts[Branches];
+}
+
+double BenchResult::perMB(HwEvent event) const
+{
+  if (!hw.counted[event] || inputBytes == 0)
+    return 0.0;
+  return hw.counts[event] / (inputBytes * double(repeat) / MB);
+}
+
+bool Bench::load(const std::vector<std::string>& files)
+{
+  _texts.clear();
+  for (auto& file : files)
+  {
+    std::ifstream in(file, std::ios::binary);
+    if (!in.good())
+      return false;
+    std::ostringstream text;
+    text << in.rdbuf();
+    _texts.push_back(text.str());
+  }
+  return true;
+}
+
+//--scans and groups every loaded file repeat times
+BenchResult Bench::run(size_t repeat) const
+{
+  BenchResult result = BenchResult();
+  result.files = _texts.size();
+  result.repeat = std::max<size_t>(repeat, 1);
+  for (auto& text : _texts)
+    result.inputBytes += text.size();
+
+  auto config = TokerConfig::defaults();
+  SemiRules::standard();   // built once per process, so not counted per run
+  size_t tokens = 0;
+  size_t semis = 0;
+  HwCounters counters;
+  if (_hardwareCounters)
+    counters.open();
+  auto start = std::chrono::steady_clock::now();
+  AllocCounter::start();
+  counters.start();
+  for (size_t r = 0; r < result.repeat; ++r)
+    for (auto& text : _texts)
+    {
+      TextBuf buf(text);
+      std::istream in(&buf);
+      Toker toker(config);
+      toker.attach(&in);
+      SemiExp semi(&toker);
+      bool more = true;
+      while (more)
+      {
+        more = semi.get();
+        tokens += semi.length();
+        ++semis;
+      }
+    }
+  result.allocs = AllocCounter::stop();
+  result.hw = counters.stop();   // copies strings, so after counting
+  result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  result.tokens = tokens / result.repeat;
+  result.semis = semis / result.repeat;
+  result.peakRss = peakRss();
+  return result;
+}
+
+//----< reporting and baselines >------------------------------------
+
+namespace
+{
+  struct Metric
+  {
+    std::string name;
+    double value;
+    double tolerance;       // default when recording
+    bool higherIsBetter;
+    bool needsCounting;
+  };
+
+  std::vector<Metric> metrics(const BenchResult& result)
+  {
+    return {
+      Metric{ "allocsPerToken", result.allocsPerToken(), 0.05, false, true },
+      Metric{ "allocBytesPerMB", result.allocBytesPerMB(), 0.05, false, true },
+      Metric{ "peakLiveBytes", double(result.allocs.peakLive), 0.10, false, true },
+      Metric{ "peakRss", double(result.peakRss), 0.25, false, false },
+      Metric{ "mbPerSecond", result.mbPerSecond(), 0.30, true, false }
+    };
+  }
+}
+
+void Scanner::showResult(const BenchResult& result, std::ostream& out)
+{
+  out << "\n  " << result.files << " files, " << result.inputBytes << " bytes, " << result.tokens
+      << " tokens, " << result.semis << " semi-expressions, x" << result.repeat;
+  out << std::fixed << std::setprecision(2);
+  out << "\n  throughput:       " << result.mbPerSecond() << " MB/s";
+  if (AllocCounter::available())
+  {
+    out << "\n  allocations:      " << result.allocs.allocations << " (" << result.allocsPerToken()
+        << " per token, " << result.allocsPerMB() << " per MB)";
+    out << "\n  bytes allocated:  " << result.allocBytesPerMB() << " per MB of input";
+    out << "\n  peak live bytes:  " << result.allocs.peakLive;
+  }
+  else
+    out << "\n  allocations:      not counted, build with BENCH_COUNT_ALLOCS";
+  out << "\n  peak RSS:         " << result.peakRss / 1024 << " KB";
+  if (result.hw.any())
+  {
+    const HwStats& hw = result.hw;
+    if (hw.counted[Cycles] && hw.counted[Instructions])
+      out << "\n  instructions:     " << result.perMB(Instructions) << " per MB, "
+          << result.instructionsPerCycle() << " per cycle";
+    else if (hw.counted[Instructions])
+      out << "\n  instructions:     " << result.perMB(Instructions) << " per MB";
+    if (hw.counted[Cycles])
+      out << "\n  cycles:           " << result.perMB(Cycles) << " per MB";
+    if (hw.counted[BranchMisses])
+    {
+      out << "\n  branch misses:    " << result.perMB(BranchMisses) << " per MB";
+      if (hw.counted[Branches])
+        out << ", " << 100 * result.branchMissRate() << "% of branches";
+    }
+    if (hw.counted[L1dMisses])
+      out << "\n  L1d read misses:  " << result.perMB(L1dMisses) << " per MB";
+    if (hw.counted[LlcMisses])
+      out << "\n  LLC misses:       " << result.perMB(LlcMisses) << " per MB";
+    for (int e = 0; e < HwEvents; ++e)
+      if (!hw.counted[e])
+      {
+        std::string label = std::string(HwCounters::name(HwEvent(e))) + ":";
+        label.resize(std::max<size_t>(label.size() + 1, 18), ' ');
+        out << "\n  " << label << "not counted";
+      }
+  }
+  else if (!result.hw.error.empty())
+    out << "\n  hw counters:      not available, " << result.hw.error;
+  out.unsetf(std::ios::floatfield);
+  out << std::setprecision(6);
+}
+
+bool Scanner::saveBaseline(const BenchResult& result, const std::string& path)
+{
+  std::ofstream out(path);
+  if (!out.good())
+    return false;
+  out << "# metric limit tolerance\n";
+  for (auto& m : metrics(result))
+    if (!m.needsCounting || AllocCounter::available())
+      out << m.name << " " << std::setprecision(8) << m.value << " " << m.tolerance << "\n";
+  return out.good();
+}
+
+//--false if the baseline can't be read or any metric regressed
+bool Scanner::checkBaseline(const BenchResult& result, const std::string& path, std::ostream& report)
+{
+  std::ifstream in(path);
+  if (!in.good())
+  {
+    report << "\n  can't read baseline " << path;
+    return false;
+  }
+  std::map<std::string, Metric> measured;
+  for (auto& m : metrics(result))
+    measured[m.name] = m;
+
+  bool ok = true;
+  std::string line;
+  while (std::getline(in, line))
+  {
+    std::istringstream fields(line);
+    std::string name;
+    double limit, tolerance;
+    if (!(fields >> name) || name[0] == '#' || !(fields >> limit >> tolerance))
+      continue;
+    auto found = measured.find(name);
+    if (found == measured.end())
+    {
+      report << "\n  " << name << ": unknown metric, ignored";
+      continue;
+    }
+    const Metric& m = found->second;
+    if (m.needsCounting && !AllocCounter::available())
+    {
+      report << "\n  " << name << ": not measured";
+      continue;
+    }
+    bool pass = m.higherIsBetter ? m.value >= limit * (1 - tolerance) : m.value <= limit * (1 + tolerance);
+    report << "\n  " << name << ": " << m.value << (m.higherIsBetter ? " (min " : " (max ")
+           << (m.higherIsBetter ? limit * (1 - tolerance) : limit * (1 + tolerance)) << ") "
+           << (pass ? "ok" : "REGRESSED");
+    ok = ok && pass;
+  }
+  return ok;
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_BENCH
+
+//--Bench [--record baseline | --check baseline] [repeat]
+int main(int argc, char* argv[])
+{
+  std::vector<std::string> files = {
+    "../Tokenizer/Tokenizer.cpp", "../Tokenizer/Tokenizer.h", "../SemiExp/SemiExp.cpp",
+    "../SemiExp/SemiExp.h", "../Analyzer/Analyzer.cpp", "../Indexer/Indexer.cpp",
+    "../TokenSearch/TokenSearch.cpp", "../Sink/Sink.cpp"
+  };
+  std::string mode = argc > 2 ? argv[1] : "";
+  std::string baseline = argc > 2 ? argv[2] : "";
+  size_t repeat = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : (argc == 2 ? std::strtoul(argv[1], nullptr, 10) : 20);
+
+  std::cout << "\n  <-----------Tokenizer Benchmark------------> \n";
+  Bench bench;
+  bench.setHardwareCounters(true);
+  if (!bench.load(files))
+  {
+    std::cout << "\n  can't read the benchmark files\n\n";
+    return 1;
+  }
+  BenchResult result = bench.run(repeat);
+  showResult(result, std::cout);
+
+  int status = 0;
+  if (mode == "--record")
+    std::cout << "\n\n  baseline " << (saveBaseline(result, baseline) ? "recorded in " : "NOT recorded in ") << baseline;
+  else if (mode == "--check")
+  {
+    bool ok = checkBaseline(result, baseline, std::cout);
+    std::cout << "\n\n  " << (ok ? "within baseline" : "FAILED: exceeds baseline");
+    status = ok ? 0 : 1;
+  }
+  std::cout << "\n\n";
+  return status;
+}
+#endif
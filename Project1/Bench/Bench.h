@@ -0,0 +1,158 @@
+#ifndef BENCH_H
+#define BENCH_H
+///////////////////////////////////////////////////////////////////////
+// Bench.h - throughput and allocation benchmark for Toker/SemiExp   //
+// ver 1.1                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package measures what the Toker + SemiExp pipeline costs per unit
+* of input: time, heap allocations, bytes allocated, the most heap bytes
+* live at once, and the process's peak resident set.  Files are read into
+* memory first, so only scanning and grouping are measured.
+*
+* Allocations are counted by replacement global operator new and delete,
+* compiled into Bench.cpp only when BENCH_COUNT_ALLOCS is defined, so no
+* other build pays for them.  They see every allocation made while
+* counting, which in this pipeline are the token strings, the SemiExp
+* token vectors and the per-file Toker.  Without the flag the allocation
+* figures read zero and AllocCounter::available() is false.
+*
+* A baseline file holds one line per metric: name, limit, tolerance.
+* checkBaseline() fails a metric that is worse than its limit by more
+* than the tolerance, a fraction of the limit; mbPerSecond must not fall
+* below its limit, the others must not rise above theirs.  Baselines are
+* recorded per platform and compiler, with saveBaseline().
+*
+* With setHardwareCounters(true), run() also reads the CPU's counters
+* through Linux perf_event_open: cycles, instructions, branches, branch
+* misses, L1 data cache read misses and last level cache misses, for
+* this thread in user mode.  showResult() then adds instructions per
+* cycle, the branch miss rate, and misses per MB of input.  Each counter
+* is opened on its own, so one the CPU lacks doesn't cost the others;
+* where none open (no PMU in a VM or container, perf_event_paranoid too
+* high, not Linux) the counts read zero and the report says why.  When
+* the kernel multiplexes counters, the counts are scaled by the time
+* each one ran.  Counters are reported but not baselined, as they vary
+* too much between CPUs.
+*
+* Public Interface:
+* -----------------
+* Bench bench;
+* bench.load(files);
+* bench.setHardwareCounters(true);       // cycles, misses, ... if available
+* BenchResult result = bench.run(10);
+* showResult(result, std::cout);
+* if (!checkBaseline(result, "BenchBaseline.txt", std::cout)) return 1;
+*
+* Build Process:
+* --------------
+* Required Files:
+*   Bench.h, Bench.cpp, SemiExp.h, SemiExp.cpp, SemiRules.h,
+*   SemiRules.cpp, Tokenizer.h, Tokenizer.cpp
+*
+* Build Command: devenv Project1.sln /rebuild debug
+* Define BENCH_COUNT_ALLOCS for allocation counts.
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 19 Oct 2026
+* - added HwCounters and Bench::setHardwareCounters(), for IPC, branch
+*   and cache miss rates from perf_event_open on Linux
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iosfwd>
+
+namespace Scanner
+{
+  struct AllocStats
+  {
+    uint64_t allocations;
+    uint64_t frees;
+    uint64_t bytes;        // total requested
+    uint64_t peakLive;     // most bytes live at once, above the level at start()
+  };
+
+  class AllocCounter
+  {
+  public:
+    static bool available();   //false unless built with BENCH_COUNT_ALLOCS
+    static void start();
+    static AllocStats stop();
+  };
+
+  size_t peakRss();   //bytes, 0 where unsupported
+
+  enum HwEvent { Cycles, Instructions, Branches, BranchMisses, L1dMisses, LlcMisses, HwEvents };
+
+  struct HwStats
+  {
+    uint64_t counts[HwEvents];
+    bool counted[HwEvents];   // false where the counter couldn't be read
+    std::string error;        // why a counter is missing, if one is
+    bool any() const;
+  };
+
+  //--this thread's hardware event counts between start() and stop()
+  class HwCounters
+  {
+  public:
+    HwCounters();
+    HwCounters(const HwCounters&) = delete;
+    HwCounters& operator=(const HwCounters&) = delete;
+    ~HwCounters();
+    bool open();        //false if no counter could be opened
+    void start();
+    HwStats stop();
+    static const char* name(HwEvent event);
+  private:
+    int _fds[HwEvents];
+    std::string _error;
+  };
+
+  struct BenchResult
+  {
+    size_t files;
+    size_t inputBytes;     // per repetition
+    size_t repeat;
+    size_t tokens;         // per repetition
+    size_t semis;          // per repetition
+    double seconds;
+    AllocStats allocs;     // all repetitions
+    size_t peakRss;
+    HwStats hw;            // all repetitions
+    double allocsPerToken() const;
+    double allocsPerMB() const;
+    double allocBytesPerMB() const;
+    double mbPerSecond() const;
+    double instructionsPerCycle() const;   //0 where not counted
+    double branchMissRate() const;         //misses per branch
+    double perMB(HwEvent event) const;
+  };
+
+  class Bench
+  {
+  public:
+    bool load(const std::vector<std::string>& files);   //false if any can't be read
+    BenchResult run(size_t repeat = 1) const;
+    void setHardwareCounters(bool value) { _hardwareCounters = value; }
+  private:
+    std::vector<std::string> _texts;
+    bool _hardwareCounters = false;
+  };
+
+  void showResult(const BenchResult& result, std::ostream& out);
+  bool saveBaseline(const BenchResult& result, const std::string& path);
+  bool checkBaseline(const BenchResult& result, const std::string& path, std::ostream& report);
+}
+#endif
@@ -0,0 +1,384 @@
+///////////////////////////////////////////////////////////////////////
+// Differential.cpp - check alternative scanners against the Toker   //
+// ver 1.1                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* Minimizing costs one comparison per trial, so it stops after MaxTrials
+* trials; on a large real file the result is then smaller than the file
+* but not minimal.  Timing covers scan() only, never group(), and every
+* input is scanned once before the clock starts.
+*
+* Build Process:
+* --------------
+* Required Files:
+*   Differential.h, Differential.cpp, SemiExp.h, SemiExp.cpp, SemiRules.h,
+*   SemiRules.cpp, Tokenizer.h, Tokenizer.cpp
+*
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 19 Oct 2026
+* - run() scans each corpus with the reference once before timing it
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <exception>
+#include <cctype>
+#include "Differential.h"
+#include "../Tokenizer/Tokenizer.h"
+#include "../SemiExp/SemiExp.h"
+
+using namespace Scanner;
+
+namespace
+{
+  const size_t MaxTrials = 20000;
+
+  //--reads a string in place
+  class TextBuf : public std::streambuf
+  {
+  public:
+    TextBuf(const std::string& text)
+    {
+      char* p = const_cast<char*>(text.data());
+      setg(p, p, p + text.size());
+    }
+  };
+
+  //--replays a token vector, counting how many were taken
+  class VectorSource : public ITokSource
+  {
+  public:
+    VectorSource(const std::vector<std::string>& toks) : _toks(toks), _pos(0) {}
+    virtual std::string getTok() { return _pos < _toks.size() ? _toks[_pos++] : ""; }
+    virtual size_t tokOffset() { return 0; }
+    size_t taken() const { return _pos; }
+  private:
+    const std::vector<std::string>& _toks;
+    size_t _pos;
+  };
+
+  void referenceScan(const std::string& text, std::vector<std::string>& toks)
+  {
+    TextBuf buf(text);
+    std::istream in(&buf);
+    Toker toker;
+    if (!toker.attach(&in))
+      return;
+    for (std::string tok = toker.getTok(); tok != ""; tok = toker.getTok())
+      toks.push_back(tok);
+  }
+
+  void referenceGroup(const std::vector<std::string>& toks, std::vector<size_t>& ends)
+  {
+    VectorSource source(toks);
+    SemiExp semi(&source);
+    bool more = true;
+    while (more)
+    {
+      more = semi.get();
+      if (ends.empty() || source.taken() > ends.back())
+        ends.push_back(source.taken());
+    }
+  }
+
+  void scan(const ScanEngine& engine, const std::string& text, std::vector<std::string>& toks)
+  {
+    try
+    {
+      engine.scan(text, toks);
+    }
+    catch (std::exception&)
+    {
+      toks.push_back("<threw>");
+    }
+  }
+
+  std::string show(const std::string& text)
+  {
+    std::string result = "\"";
+    for (char ch : text)
+    {
+      if (ch == '\n')
+        result += "\\n";
+      else if (ch == '\t')
+        result += "\\t";
+      else if (ch == '\\' || ch == '"')
+        result += std::string("\\") + ch;
+      else if (!std::isprint(static_cast<unsigned char>(ch)))
+      {
+        static const char* hex = "0123456789abcdef";
+        result += std::string("\\x") + hex[(ch >> 4) & 0xf] + hex[ch & 0xf];
+      }
+      else
+        result += ch;
+    }
+    return result + "\"";
+  }
+
+  template <typename T>
+  size_t firstMismatch(const std::vector<T>& a, const std::vector<T>& b)
+  {
+    size_t i = 0;
+    while (i < a.size() && i < b.size() && a[i] == b[i])
+      ++i;
+    return i;
+  }
+}
+
+DiffHarness::DiffHarness() : _reference(reference()) {}
+
+//--the Toker and SemiExp that other engines must match
+ScanEngine DiffHarness::reference()
+{
+  return ScanEngine{ "reference", referenceScan, referenceGroup };
+}
+
+void DiffHarness::addEngine(const ScanEngine& engine)
+{
+  _engines.push_back(engine);
+}
+
+void DiffHarness::addCorpus(const std::string& name, const std::vector<std::string>& texts)
+{
+  _corpora.push_back(Corpus{ name, texts });
+}
+
+bool DiffHarness::addFiles(const std::string& name, const std::vector<std::string>& files)
+{
+  Corpus corpus{ name, {} };
+  for (auto& file : files)
+  {
+    std::ifstream in(file, std::ios::binary);
+    if (!in.good())
+      return false;
+    std::ostringstream text;
+    text << in.rdbuf();
+    corpus.texts.push_back(text.str());
+  }
+  _corpora.push_back(corpus);
+  return true;
+}
+
+//--true if engine disagrees with the reference on text
+bool DiffHarness::differs(const ScanEngine& engine, const std::string& text, std::string* pDifference) const
+{
+  std::vector<std::string> expected, actual;
+  scan(_reference, text, expected);
+  scan(engine, text, actual);
+  if (expected != actual)
+  {
+    if (pDifference != nullptr)
+    {
+      size_t i = firstMismatch(expected, actual);
+      *pDifference = "token " + std::to_string(i) + ": reference "
+        + (i < expected.size() ? show(expected[i]) : "end") + ", " + engine.name + " "
+        + (i < actual.size() ? show(actual[i]) : "end");
+    }
+    return true;
+  }
+  if (!engine.group)
+    return false;
+  std::vector<size_t> expectedEnds, actualEnds;
+  _reference.group(expected, expectedEnds);
+  engine.group(actual, actualEnds);
+  if (expectedEnds == actualEnds)
+    return false;
+  if (pDifference != nullptr)
+  {
+    size_t i = firstMismatch(expectedEnds, actualEnds);
+    *pDifference = "semi-expression " + std::to_string(i) + ": reference ends after token "
+      + (i < expectedEnds.size() ? std::to_string(expectedEnds[i]) : "-") + ", " + engine.name + " after "
+      + (i < actualEnds.size() ? std::to_string(actualEnds[i]) : "-");
+  }
+  return true;
+}
+
+//--removes characters for as long as the engine still disagrees
+std::string DiffHarness::minimize(const ScanEngine& engine, const std::string& text) const
+{
+  std::string current = text;
+  size_t trials = 0;
+  size_t chunk = std::max<size_t>(current.size() / 2, 1);
+  while (trials < MaxTrials)
+  {
+    bool removed = false;
+    for (size_t pos = 0; pos < current.size() && trials < MaxTrials; ++trials)
+    {
+      std::string trial = current.substr(0, pos) + current.substr(std::min(pos + chunk, current.size()));
+      if (differs(engine, trial))
+      {
+        current = trial;
+        removed = true;
+      }
+      else
+        pos += chunk;
+    }
+    if (!removed)
+    {
+      if (chunk == 1)
+        break;
+      chunk /= 2;
+    }
+  }
+  return current;
+}
+
+double DiffHarness::time(const ScanEngine& engine, const Corpus& corpus, size_t repeat) const
+{
+  std::vector<std::string> toks;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t r = 0; r < repeat; ++r)
+    for (auto& text : corpus.texts)
+    {
+      toks.clear();
+      scan(engine, text, toks);
+    }
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+//--one report per engine and corpus
+std::vector<DiffReport> DiffHarness::run(size_t repeat) const
+{
+  std::vector<DiffReport> reports;
+  for (auto& corpus : _corpora)
+  {
+    time(_reference, corpus, 1);   // untimed, as differs() warms each engine
+    double referenceSeconds = time(_reference, corpus, repeat);
+    for (auto& engine : _engines)
+    {
+      DiffReport report{ engine.name, corpus.name, corpus.texts.size(), 0, "", "", referenceSeconds, 0.0 };
+      for (auto& text : corpus.texts)
+      {
+        if (!differs(engine, text))
+          continue;
+        if (report.failures++ == 0)
+        {
+          report.minimized = minimize(engine, text);
+          differs(engine, report.minimized, &report.firstDifference);
+        }
+      }
+      report.engineSeconds = time(engine, corpus, repeat);
+      reports.push_back(report);
+    }
+  }
+  return reports;
+}
+
+//--random inputs built from fragments that exercise the Toker's rules
+std::vector<std::string> DiffHarness::generate(size_t count, size_t fragments, unsigned seed)
+{
+  static const char* pieces[] = {
+    "int", "x1", "_y", "42", "3.14", " ", "  ", "\t", "\n", "\n\n",
+    "\"str\"", "\"a\\\"b\"", "\"\\\\\"", "'c'", "'\\''", "'\\\\'", "\"unterminated", "\"two\nlines\"",
+    "\\n", "\\", "\\\\", "\\\"", "\"\\n\"",
+    "// comment\n", "/* c */", "/* two\n lines */", "/*", "//", "*/",
+    "<<", ">>", "::", "->", "++", "--", "==", "!=", "<=", ">=", "&&", "||", "+=", "<<=", "...",
+    "{", "}", ";", "(", ")", "[", "]", ",", ":", "#", "#include <x.h>\n", "#define A 1\n",
+    "for (i = 0; i < n; ++i)", "for(;;)", "public:", "private:", "protected:",
+    "?", "~", "!", "%", "^", "&", "|", "*", "/", "=", "-", "+", ".", "@", "$", "`"
+  };
+  const size_t pieceCount = sizeof(pieces) / sizeof(pieces[0]);
+  std::mt19937 random(seed);
+  std::uniform_int_distribution<size_t> pick(0, pieceCount - 1);
+  std::vector<std::string> texts(count);
+  for (auto& text : texts)
+    for (size_t i = 0; i < fragments; ++i)
+      text += pieces[pick(random)];
+  return texts;
+}
+
+void Scanner::showReport(const DiffReport& report, std::ostream& out)
+{
+  out << "\n  " << report.engine << " on " << report.corpus << ": " << report.failures << " of "
+      << report.inputs << " inputs differ, speedup " << std::fixed << std::setprecision(2)
+      << report.speedup() << "x";
+  out.unsetf(std::ios::floatfield);
+  if (report.failures > 0)
+  {
+    out << "\n    minimized input: " << show(report.minimized);
+    out << "\n    " << report.firstDifference;
+  }
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_DIFFERENTIAL
+
+namespace
+{
+  //--the reference Toker, restarted from a checkpoint every few tokens
+  void resumedScan(const std::string& text, std::vector<std::string>& toks)
+  {
+    std::istringstream in(text);
+    TokerCheckpoint cp{ 0, EOF };
+    bool first = true;
+    while (true)
+    {
+      Toker toker;
+      if (first ? !toker.attach(&in) : !toker.resume(&in, cp))
+        return;
+      first = false;
+      size_t n = 0;
+      std::string tok;
+      for (; n < 7 && (tok = toker.getTok()) != ""; ++n)
+        toks.push_back(tok);
+      if (n < 7)
+        return;
+      cp = toker.checkpoint();
+      in.clear();
+    }
+  }
+
+  //--a naive splitter: words, and one token per other character
+  void naiveScan(const std::string& text, std::vector<std::string>& toks)
+  {
+    for (size_t i = 0; i < text.size();)
+    {
+      unsigned char ch = text[i];
+      if (std::isalnum(ch) || ch == '_')
+      {
+        size_t j = i;
+        while (j < text.size() && (std::isalnum(static_cast<unsigned char>(text[j])) || text[j] == '_'))
+          ++j;
+        toks.push_back(text.substr(i, j - i));
+        i = j;
+      }
+      else
+      {
+        if (!std::isspace(ch) || ch == '\n')
+          toks.push_back(std::string(1, text[i]));
+        ++i;
+      }
+    }
+  }
+}
+
+int main()
+{
+  std::cout << "\n  <-----------Differential Scanner Check------------> \n";
+  DiffHarness harness;
+  harness.addEngine(ScanEngine{ "resumed", resumedScan, ScanEngine::Group() });
+  harness.addEngine(ScanEngine{ "naive", naiveScan, ScanEngine::Group() });
+  harness.addCorpus("generated", DiffHarness::generate(300, 40, 1));
+  if (!harness.addFiles("sources", { "../Tokenizer/Tokenizer.cpp", "../SemiExp/SemiExp.cpp" }))
+    std::cout << "\n  can't read the source files";
+  for (auto& report : harness.run(3))
+    showReport(report, std::cout);
+  std::cout << "\n\n";
+  return 0;
+}
+#endif
@@ -0,0 +1,114 @@
+#ifndef DIFFERENTIAL_H
+#define DIFFERENTIAL_H
+///////////////////////////////////////////////////////////////////////
+// Differential.h - check alternative scanners against the Toker     //
+// ver 1.1                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* A faster scanner is only a replacement for Toker if it returns exactly
+* the same tokens, quirks included: "\n" outside quotes read as one
+* token, the escaped quote handling of quoted strings, where punctuator
+* runs stop.  DiffHarness runs the reference Toker and any number of
+* other ScanEngines over the same corpora and, for every input, compares
+*   - the token streams, token for token, and
+*   - the SemiExp boundaries: how many tokens each SemiExp::get() took.
+* Boundaries are compared only for an engine that groups tokens itself
+* and supplies a group function; other engines are checked on tokens.
+*
+* For each failing input the harness reports the first difference and a
+* minimized input: characters are removed, in halving chunk sizes, for
+* as long as the engine still disagrees with the reference, so what is
+* left is usually a handful of characters.  Each corpus is also timed
+* with both engines, giving a speedup per corpus.
+*
+* generate() makes random inputs from fragments chosen to reach the
+* Toker's quirks; a seed makes a corpus reproducible.  An engine that
+* throws is recorded as having returned the token "<threw>", so engines
+* must agree on which inputs are rejected, too.
+*
+* Public Interface:
+* -----------------
+* DiffHarness harness;                                  // reference Toker
+* harness.addEngine(ScanEngine{ "fast", fastScan });
+* harness.addCorpus("generated", DiffHarness::generate(500, 200, 1));
+* harness.addFiles("sources", files);
+* for (auto& report : harness.run(5)) showReport(report, std::cout);
+*
+* Build Process:
+* --------------
+* Required Files:
+*   Differential.h, Differential.cpp, SemiExp.h, SemiExp.cpp, SemiRules.h,
+*   SemiRules.cpp, Tokenizer.h, Tokenizer.cpp
+*
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 19 Oct 2026
+* - the reference Toker is warmed up before it is timed, as engines are
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <iosfwd>
+
+namespace Scanner
+{
+  struct ScanEngine
+  {
+    using Scan = std::function<void(const std::string& text, std::vector<std::string>& toks)>;
+    using Group = std::function<void(const std::vector<std::string>& toks, std::vector<size_t>& ends)>;
+    std::string name;
+    Scan scan;       // text to tokens
+    Group group;     // tokens to the end of each semi-expression; may be empty
+  };
+
+  struct DiffReport
+  {
+    std::string engine;
+    std::string corpus;
+    size_t inputs;
+    size_t failures;
+    std::string firstDifference;   // of the first failing input, minimized
+    std::string minimized;
+    double referenceSeconds;
+    double engineSeconds;
+    double speedup() const { return engineSeconds > 0 ? referenceSeconds / engineSeconds : 0.0; }
+  };
+
+  class DiffHarness
+  {
+  public:
+    DiffHarness();
+    void addEngine(const ScanEngine& engine);
+    void addCorpus(const std::string& name, const std::vector<std::string>& texts);
+    bool addFiles(const std::string& name, const std::vector<std::string>& files);
+    std::vector<DiffReport> run(size_t repeat = 1) const;
+    bool differs(const ScanEngine& engine, const std::string& text, std::string* pDifference = nullptr) const;
+    std::string minimize(const ScanEngine& engine, const std::string& text) const;
+    static ScanEngine reference();
+    static std::vector<std::string> generate(size_t count, size_t fragments, unsigned seed);
+  private:
+    struct Corpus
+    {
+      std::string name;
+      std::vector<std::string> texts;
+    };
+    double time(const ScanEngine& engine, const Corpus& corpus, size_t repeat) const;
+    ScanEngine _reference;
+    std::vector<ScanEngine> _engines;
+    std::vector<Corpus> _corpora;
+  };
+
+  void showReport(const DiffReport& report, std::ostream& out);
+}
+#endif
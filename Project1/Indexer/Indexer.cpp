@@ -0,0 +1,663 @@
+///////////////////////////////////////////////////////////////////////
+// Indexer.cpp - persistent identifier index over a source tree      //
+// ver 1.4                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* Index file layout, all integers in native byte order:
+*
+*   Header    magic, version, file and term counts, section offsets
+*   Files     per file: name (offset, length), size, modification time
+*   Terms     per identifier, sorted by name: name (offset, length),
+*             offset of its postings, posting count, block count
+*   Strings   file names and identifier names, not terminated
+*   Postings  per term: block directory {first file, first line, data
+*             offset} followed by the varint-encoded block data
+*
+* Inside a block each posting after the first stores the file delta and
+* then either the line delta (same file) or the absolute line (new file).
+* Identifiers are words of letters, digits and underscores that start
+* with a letter or underscore.  The Toker returns '_' as a punctuator,
+* so indexFile() joins word pieces whose offsets touch, as TokStats
+* does, before taking them as identifiers; their lines come from the
+* offset of their first piece through a LineIndex of the file.
+*
+* Build Process:
+* --------------
+* Required Files:
+*   Indexer.h, Indexer.cpp, Tokenizer.h, Tokenizer.cpp, LineIndex.h,
+*   LineIndex.cpp, ScannerPool.h, ScannerPool.cpp, SemiExp.h, SemiExp.cpp,
+*   SemiRules.h, SemiRules.cpp
+*
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.4 : 19 Oct 2026
+* - identifiers the Toker splits at '_', such as size_t, are indexed
+*   whole
+* ver 1.3 : 19 Oct 2026
+* - a file the Toker throws on keeps no postings and is reported as
+*   unreadable, instead of ending the process from a worker thread
+* ver 1.2 : 19 Oct 2026
+* - scans with Tokers leased from the thread's ScannerPool
+* ver 1.1 : 19 Oct 2026
+* - lines resolved from token offsets, correct across block comments
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <unordered_map>
+#include <map>
+#include <thread>
+#include <atomic>
+#include <cstring>
+#include <cctype>
+#include <cstdio>
+#include <stdexcept>
+#include <sys/types.h>
+#include <sys/stat.h>
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include "Indexer.h"
+#include "../Tokenizer/Tokenizer.h"
+#include "../ScannerPool/ScannerPool.h"
+#include "../LineIndex/LineIndex.h"
+
+using namespace Scanner;
+
+namespace
+{
+  const uint32_t IndexMagic = 0x58444954;   // "TIDX"
+  const uint32_t IndexVersion = 1;
+  const size_t BlockSize = 128;
+
+  struct Header
+  {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t fileCount;
+    uint32_t termCount;
+    uint64_t files;
+    uint64_t terms;
+    uint64_t strings;
+    uint64_t postings;
+  };
+
+  struct FileEntry
+  {
+    uint32_t nameOff;
+    uint32_t nameLen;
+    uint64_t size;
+    int64_t mtime;
+  };
+
+  struct TermEntry
+  {
+    uint32_t nameOff;
+    uint32_t nameLen;
+    uint64_t postings;   // from the start of the postings section
+    uint32_t count;
+    uint32_t blocks;
+  };
+
+  struct BlockEntry
+  {
+    uint32_t file;
+    uint32_t line;
+    uint32_t offset;   // from the start of the term's block data
+  };
+
+  struct FileRecord
+  {
+    std::string name;
+    uint64_t size;
+    int64_t mtime;
+  };
+
+  using TermMap = std::map<std::string, std::vector<Posting>>;
+
+  //--size and modification time identify an unchanged file
+  bool stampOf(const std::string& path, FileRecord& rec)
+  {
+#ifdef _WIN32
+    struct _stat64 st;
+    if (_stat64(path.c_str(), &st) != 0)
+      return false;
+#else
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0)
+      return false;
+#endif
+    rec.name = path;
+    rec.size = static_cast<uint64_t>(st.st_size);
+    rec.mtime = static_cast<int64_t>(st.st_mtime);
+    return true;
+  }
+
+  void putVarint(std::string& out, uint32_t value)
+  {
+    while (value >= 0x80)
+    {
+      out += static_cast<char>((value & 0x7f) | 0x80);
+      value >>= 7;
+    }
+    out += static_cast<char>(value);
+  }
+
+  uint32_t getVarint(const unsigned char*& p)
+  {
+    uint32_t value = 0;
+    int shift = 0;
+    while (*p & 0x80)
+    {
+      value |= static_cast<uint32_t>(*p++ & 0x7f) << shift;
+      shift += 7;
+    }
+    value |= static_cast<uint32_t>(*p++) << shift;
+    return value;
+  }
+
+  //--binary search of the sorted term table
+  const TermEntry* findTerm(const char* base, const std::string& ident)
+  {
+    if (base == nullptr)
+      return nullptr;
+    const Header* header = reinterpret_cast<const Header*>(base);
+    const TermEntry* terms = reinterpret_cast<const TermEntry*>(base + header->terms);
+    const char* strings = base + header->strings;
+    size_t lo = 0, hi = header->termCount;
+    while (lo < hi)
+    {
+      size_t mid = (lo + hi) / 2;
+      const TermEntry& term = terms[mid];
+      int cmp = std::memcmp(strings + term.nameOff, ident.data(), std::min<size_t>(term.nameLen, ident.size()));
+      if (cmp == 0)
+        cmp = (term.nameLen < ident.size()) ? -1 : (term.nameLen > ident.size() ? 1 : 0);
+      if (cmp == 0)
+        return &term;
+      if (cmp < 0)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    return nullptr;
+  }
+
+  const BlockEntry* blocksOf(const char* base, const TermEntry* term)
+  {
+    const Header* header = reinterpret_cast<const Header*>(base);
+    return reinterpret_cast<const BlockEntry*>(base + header->postings + term->postings);
+  }
+
+  //--decodes blocks [first, last) of a term's postings into out
+  void decodeBlocks(const char* base, const TermEntry* term, size_t first, size_t last, std::vector<Posting>& out)
+  {
+    const BlockEntry* dir = blocksOf(base, term);
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(dir + term->blocks);
+    for (size_t b = first; b < last; ++b)
+    {
+      size_t count = std::min<size_t>(BlockSize, term->count - b * BlockSize);
+      const unsigned char* p = data + dir[b].offset;
+      Posting post{ dir[b].file, dir[b].line };
+      out.push_back(post);
+      for (size_t i = 1; i < count; ++i)
+      {
+        uint32_t fileDelta = getVarint(p);
+        uint32_t line = getVarint(p);
+        post.file += fileDelta;
+        post.line = (fileDelta == 0) ? post.line + line : line;
+        out.push_back(post);
+      }
+    }
+  }
+
+  template<typename T>
+  void putRaw(std::string& out, const T& value)
+  {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  bool isWordChar(char ch)
+  {
+    return std::isalnum(static_cast<unsigned char>(ch)) || ch == '_';
+  }
+
+  //--comments and quoted text hold no identifiers
+  bool isWhole(const std::string& tok)
+  {
+    return tok == "\n" || tok[0] == '"' || tok[0] == '\'' || tok.compare(0, 2, "//") == 0 || tok.compare(0, 2, "/*") == 0;
+  }
+
+  //--collects the identifier postings of one file; false, with none
+  //  kept, if the Toker throws on it
+  bool indexFile(const std::string& path, uint32_t file, std::unordered_map<std::string, std::vector<Posting>>& terms)
+  {
+    std::ifstream in(path, std::ios::binary);
+    ScannerPool::Lease scanner = ScannerPool::local().acquire(&in);
+    if (!scanner.attached())
+      return false;
+    Toker& toker = scanner.toker();
+    LineIndex lines(path);
+    std::vector<std::vector<Posting>*> touched;
+    std::string word;                    // touching word pieces read so far
+    size_t wordStart = 0, wordEnd = 0;   // offsets of the first and just past them
+    auto flush = [&]() {
+      if (!word.empty() && !std::isdigit(static_cast<unsigned char>(word[0])))
+      {
+        uint32_t line = static_cast<uint32_t>(lines.position(wordStart).line);
+        std::vector<Posting>& list = terms[word];
+        if (list.empty() || list.back().file != file)
+          touched.push_back(&list);
+        list.push_back(Posting{ file, line });
+      }
+      word.clear();
+    };
+    try
+    {
+      for (std::string tok = toker.getTok(); tok != ""; tok = toker.getTok())
+      {
+        size_t offset = toker.tokOffset();
+        if (isWhole(tok) || (!isWordChar(tok[0]) && tok.find('_') == std::string::npos))
+        {
+          flush();
+          continue;
+        }
+        for (size_t i = 0, j = 0; i < tok.size(); i = j)
+        {
+          bool inWord = isWordChar(tok[i]);
+          while (j < tok.size() && isWordChar(tok[j]) == inWord)
+            ++j;
+          if (!inWord || wordEnd != offset + i)
+            flush();
+          if (!inWord)
+            continue;
+          if (word.empty())
+            wordStart = offset + i;
+          word.append(tok, i, j - i);
+          wordEnd = offset + j;
+        }
+      }
+      flush();
+    }
+    catch (std::exception&)   // bytes the Toker can't classify, such as a BOM
+    {
+      for (std::vector<Posting>* pList : touched)
+        while (pList->size() > 0 && pList->back().file == file)
+          pList->pop_back();
+      return false;
+    }
+    return true;
+  }
+
+  //--tokenizes files[which[i]] as file id ids[i] on several threads
+  void scanFiles(const std::vector<std::string>& files, const std::vector<size_t>& which,
+    const std::vector<uint32_t>& ids, size_t nThreads, TermMap& terms, std::vector<size_t>* pUnreadable)
+  {
+    if (nThreads == 0)
+      nThreads = std::max(1u, std::thread::hardware_concurrency());
+    nThreads = std::max(size_t(1), std::min(nThreads, which.size()));
+    std::vector<std::unordered_map<std::string, std::vector<Posting>>> local(nThreads);
+    std::vector<std::vector<size_t>> unreadable(nThreads);
+    std::atomic<size_t> next(0);
+    auto worker = [&](size_t t) {
+      size_t i;
+      while ((i = next++) < which.size())
+        if (!indexFile(files[which[i]], ids[i], local[t]))
+          unreadable[t].push_back(which[i]);
+    };
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < nThreads; ++t)
+      threads.push_back(std::thread(worker, t));
+    worker(0);
+    for (auto& thrd : threads)
+      thrd.join();
+    for (auto& part : local)
+      for (auto& term : part)
+      {
+        auto& dest = terms[term.first];
+        dest.insert(dest.end(), term.second.begin(), term.second.end());
+      }
+    if (pUnreadable != nullptr)
+    {
+      for (auto& u : unreadable)
+        pUnreadable->insert(pUnreadable->end(), u.begin(), u.end());
+      std::sort(pUnreadable->begin(), pUnreadable->end());
+    }
+  }
+
+  //--serializes files and terms and atomically replaces indexPath
+  bool writeIndex(const std::string& indexPath, const std::vector<FileRecord>& files, TermMap& terms)
+  {
+    std::string fileTable, termTable, strings, postings;
+    for (auto& rec : files)
+    {
+      FileEntry entry{ static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(rec.name.size()), rec.size, rec.mtime };
+      strings += rec.name;
+      putRaw(fileTable, entry);
+    }
+    for (auto& term : terms)
+    {
+      std::vector<Posting>& list = term.second;
+      std::sort(list.begin(), list.end(), [](const Posting& a, const Posting& b) {
+        return a.file != b.file ? a.file < b.file : a.line < b.line;
+      });
+      list.erase(std::unique(list.begin(), list.end(), [](const Posting& a, const Posting& b) {
+        return a.file == b.file && a.line == b.line;
+      }), list.end());
+      if (list.size() == 0)
+        continue;
+
+      while (postings.size() % 8 != 0)
+        postings += '\0';
+      uint32_t blocks = static_cast<uint32_t>((list.size() + BlockSize - 1) / BlockSize);
+      std::string dir, data;
+      for (size_t b = 0; b < blocks; ++b)
+      {
+        size_t first = b * BlockSize;
+        size_t last = std::min(first + BlockSize, list.size());
+        putRaw(dir, BlockEntry{ list[first].file, list[first].line, static_cast<uint32_t>(data.size()) });
+        for (size_t i = first + 1; i < last; ++i)
+        {
+          uint32_t fileDelta = list[i].file - list[i - 1].file;
+          putVarint(data, fileDelta);
+          putVarint(data, fileDelta == 0 ? list[i].line - list[i - 1].line : list[i].line);
+        }
+      }
+      TermEntry entry{ static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(term.first.size()),
+        static_cast<uint64_t>(postings.size()), static_cast<uint32_t>(list.size()), blocks };
+      strings += term.first;
+      putRaw(termTable, entry);
+      postings += dir;
+      postings += data;
+    }
+
+    Header header;
+    header.magic = IndexMagic;
+    header.version = IndexVersion;
+    header.fileCount = static_cast<uint32_t>(files.size());
+    header.termCount = static_cast<uint32_t>(termTable.size() / sizeof(TermEntry));
+    header.files = sizeof(Header);
+    header.terms = header.files + fileTable.size();
+    header.strings = header.terms + termTable.size();
+    header.postings = (header.strings + strings.size() + 7) & ~uint64_t(7);
+
+    std::string tmpPath = indexPath + ".tmp";
+    {
+      std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+      if (!out.good())
+        return false;
+      out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      out << fileTable << termTable << strings;
+      out << std::string(static_cast<size_t>(header.postings - header.strings - strings.size()), '\0');
+      out << postings;
+      if (!out.good())
+        return false;
+    }
+    std::remove(indexPath.c_str());
+    return std::rename(tmpPath.c_str(), indexPath.c_str()) == 0;
+  }
+}
+
+#ifdef _WIN32
+struct Mapping { HANDLE file; HANDLE map; };
+#endif
+
+IdentIndex::IdentIndex() : _pMapping(nullptr), _base(nullptr), _size(0) {}
+
+IdentIndex::~IdentIndex() { close(); }
+
+//--tokenizes files and writes a fresh index
+bool IdentIndex::build(const std::vector<std::string>& files, const std::string& indexPath, size_t nThreads,
+  std::vector<size_t>* pUnreadable)
+{
+  if (pUnreadable != nullptr)
+    pUnreadable->clear();
+  std::vector<FileRecord> records;
+  std::vector<size_t> which;
+  std::vector<uint32_t> ids;
+  for (size_t i = 0; i < files.size(); ++i)
+  {
+    FileRecord rec;
+    if (!stampOf(files[i], rec))
+      continue;
+    which.push_back(i);
+    ids.push_back(static_cast<uint32_t>(records.size()));
+    records.push_back(rec);
+  }
+  TermMap terms;
+  scanFiles(files, which, ids, nThreads, terms, pUnreadable);
+  return writeIndex(indexPath, records, terms);
+}
+
+//--maps an index file and checks its header
+bool IdentIndex::open(const std::string& indexPath)
+{
+  close();
+#ifdef _WIN32
+  HANDLE file = CreateFileA(indexPath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+  LARGE_INTEGER size;
+  GetFileSizeEx(file, &size);
+  HANDLE map = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (map == NULL)
+  {
+    CloseHandle(file);
+    return false;
+  }
+  _base = static_cast<const char*>(MapViewOfFile(map, FILE_MAP_READ, 0, 0, 0));
+  _size = static_cast<size_t>(size.QuadPart);
+  _pMapping = new Mapping{ file, map };
+#else
+  int fd = ::open(indexPath.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0)
+  {
+    ::close(fd);
+    return false;
+  }
+  void* addr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (addr == MAP_FAILED)
+    return false;
+  _base = static_cast<const char*>(addr);
+  _size = static_cast<size_t>(st.st_size);
+  _pMapping = addr;
+#endif
+  const Header* header = reinterpret_cast<const Header*>(_base);
+  if (_base == nullptr || _size < sizeof(Header) || header->magic != IndexMagic || header->version != IndexVersion)
+  {
+    close();
+    return false;
+  }
+  return true;
+}
+
+void IdentIndex::close()
+{
+  if (_pMapping == nullptr)
+    return;
+#ifdef _WIN32
+  Mapping* mapping = static_cast<Mapping*>(_pMapping);
+  if (_base != nullptr)
+    UnmapViewOfFile(_base);
+  CloseHandle(mapping->map);
+  CloseHandle(mapping->file);
+  delete mapping;
+#else
+  munmap(_pMapping, _size);
+#endif
+  _pMapping = nullptr;
+  _base = nullptr;
+  _size = 0;
+}
+
+size_t IdentIndex::fileCount() const
+{
+  return _base ? reinterpret_cast<const Header*>(_base)->fileCount : 0;
+}
+
+size_t IdentIndex::termCount() const
+{
+  return _base ? reinterpret_cast<const Header*>(_base)->termCount : 0;
+}
+
+std::string IdentIndex::fileName(uint32_t file) const
+{
+  if (file >= fileCount())
+    throw(std::invalid_argument("index out of range"));
+  const Header* header = reinterpret_cast<const Header*>(_base);
+  const FileEntry* entry = reinterpret_cast<const FileEntry*>(_base + header->files) + file;
+  return std::string(_base + header->strings + entry->nameOff, entry->nameLen);
+}
+
+std::vector<Posting> IdentIndex::query(const std::string& ident) const
+{
+  std::vector<Posting> out;
+  const TermEntry* term = findTerm(_base, ident);
+  if (term != nullptr)
+  {
+    out.reserve(term->count);
+    decodeBlocks(_base, term, 0, term->blocks, out);
+  }
+  return out;
+}
+
+//--decodes only the blocks that can hold postings of file
+std::vector<Posting> IdentIndex::queryFile(const std::string& ident, uint32_t file) const
+{
+  std::vector<Posting> out;
+  const TermEntry* term = findTerm(_base, ident);
+  if (term == nullptr)
+    return out;
+  const BlockEntry* dir = blocksOf(_base, term);
+  size_t first = std::lower_bound(dir, dir + term->blocks, file,
+    [](const BlockEntry& b, uint32_t f) { return b.file < f; }) - dir;
+  if (first > 0)
+    --first;
+  size_t last = first;
+  while (last < term->blocks && dir[last].file <= file)
+    ++last;
+  decodeBlocks(_base, term, first, last, out);
+  out.erase(std::remove_if(out.begin(), out.end(), [file](const Posting& p) { return p.file != file; }), out.end());
+  return out;
+}
+
+//--re-tokenizes changed and new files, keeps postings of the others
+bool IdentIndex::update(const std::vector<std::string>& files, const std::string& indexPath, size_t nThreads,
+  std::vector<size_t>* pUnreadable)
+{
+  if (pUnreadable != nullptr)
+    pUnreadable->clear();
+  if (!open(indexPath))
+  {
+    if (!build(files, indexPath, nThreads, pUnreadable))
+      return false;
+    return open(indexPath);
+  }
+  std::unordered_map<std::string, uint32_t> oldIds;
+  for (uint32_t f = 0; f < fileCount(); ++f)
+    oldIds[fileName(f)] = f;
+
+  const Header* header = reinterpret_cast<const Header*>(_base);
+  const FileEntry* oldFiles = reinterpret_cast<const FileEntry*>(_base + header->files);
+  std::vector<FileRecord> records;
+  std::vector<uint32_t> remap(fileCount(), UINT32_MAX);
+  std::vector<size_t> which;
+  std::vector<uint32_t> ids;
+  for (size_t i = 0; i < files.size(); ++i)
+  {
+    FileRecord rec;
+    if (!stampOf(files[i], rec))
+      continue;
+    uint32_t id = static_cast<uint32_t>(records.size());
+    auto iter = oldIds.find(files[i]);
+    if (iter != oldIds.end() && oldFiles[iter->second].size == rec.size && oldFiles[iter->second].mtime == rec.mtime)
+      remap[iter->second] = id;
+    else
+    {
+      which.push_back(i);
+      ids.push_back(id);
+    }
+    records.push_back(rec);
+  }
+
+  TermMap terms;
+  const TermEntry* oldTerms = reinterpret_cast<const TermEntry*>(_base + header->terms);
+  for (uint32_t t = 0; t < header->termCount; ++t)
+  {
+    std::vector<Posting> list;
+    decodeBlocks(_base, &oldTerms[t], 0, oldTerms[t].blocks, list);
+    std::vector<Posting> kept;
+    for (auto& p : list)
+      if (remap[p.file] != UINT32_MAX)
+        kept.push_back(Posting{ remap[p.file], p.line });
+    if (kept.size() > 0)
+      terms[std::string(_base + header->strings + oldTerms[t].nameOff, oldTerms[t].nameLen)] = std::move(kept);
+  }
+  close();
+  if (which.size() > 0)
+    scanFiles(files, which, ids, nThreads, terms, pUnreadable);
+  if (!writeIndex(indexPath, records, terms))
+    return false;
+  return open(indexPath);
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_INDEXER
+
+int main()
+{
+  std::vector<std::string> files = {
+    "../Tokenizer/TokenizerTestFile.txt", "../SemiExp/SemiExpTestFile.txt", "../ITokTestFile.txt",
+    "../Tokenizer/BomTestFile.txt"
+  };
+  std::string indexPath = "ident.idx";
+  std::cout << "\n  <-----------Identifier Index------------> \n";
+  std::vector<size_t> unreadable;
+  if (!IdentIndex::build(files, indexPath, 0, &unreadable))
+  {
+    std::cout << "\n  can't write " << indexPath << "\n\n";
+    return 1;
+  }
+  for (size_t file : unreadable)
+    std::cout << "\n  " << files[file] << ": unreadable";
+  IdentIndex index;
+  if (!index.update(files, indexPath))   // nothing changed, nothing re-tokenized
+  {
+    std::cout << "\n  can't open " << indexPath << "\n\n";
+    return 1;
+  }
+  std::cout << "\n  " << index.fileCount() << " files, " << index.termCount() << " identifiers";
+  for (std::string ident : { "cout", "Test", "public", "Tokenizer", "TABLE_SIZE", "missing" })
+  {
+    std::cout << "\n\n  " << ident << ":";
+    for (auto& p : index.query(ident))
+      std::cout << "\n    " << index.fileName(p.file) << "(" << p.line << ")";
+  }
+  std::cout << "\n\n  Test in " << index.fileName(1) << ":";
+  for (auto& p : index.queryFile("Test", 1))
+    std::cout << " " << p.line;
+  index.close();
+  std::remove(indexPath.c_str());
+  std::cout << "\n\n";
+  return 0;
+}
+#endif
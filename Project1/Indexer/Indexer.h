@@ -0,0 +1,102 @@
+#ifndef INDEXER_H
+#define INDEXER_H
+///////////////////////////////////////////////////////////////////////
+// Indexer.h - persistent identifier index over a source tree        //
+// ver 1.3                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package provides a public IdentIndex class that answers "which
+* files and lines use identifier X" without re-tokenizing the tree.
+* IdentIndex::build() tokenizes files with Toker, on several threads,
+* and writes an inverted index file: identifier -> postings of
+* (file, line).  IdentIndex::open() memory-maps that file, and query()
+* finds an identifier by binary search over the sorted term table and
+* decodes its postings directly from the mapping.
+*
+* Postings are sorted by file and line, delta-encoded as varints and
+* cut into blocks of 128.  A small directory holding the first posting
+* of each block lets queryFile() jump straight to one file's postings.
+*
+* update() compares size and modification time of every file against
+* those recorded in the index, re-tokenizes only the files that changed
+* or are new, carries the postings of unchanged files over as they are,
+* and drops files no longer listed.
+*
+* A file holding bytes the Toker rejects, such as a UTF-8 byte order
+* mark, is kept in the file table with no postings.  build() and
+* update() list it, by its index in files, as unreadable.
+*
+* Public Interface:
+* -----------------
+* std::vector<size_t> unreadable;
+* IdentIndex::build(files, "tree.idx", 0, &unreadable);
+* IdentIndex index;
+* index.open("tree.idx");
+* for (auto& p : index.query("SemiExp"))
+*   std::cout << index.fileName(p.file) << "(" << p.line << ")";
+* index.update(files, "tree.idx");
+*
+* Build Process:
+* --------------
+* Required Files:
+*   Indexer.h, Indexer.cpp, Tokenizer.h, Tokenizer.cpp, LineIndex.h,
+*   LineIndex.cpp, ScannerPool.h, ScannerPool.cpp, SemiExp.h, SemiExp.cpp,
+*   SemiRules.h, SemiRules.cpp
+*
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.3 : 19 Oct 2026
+* - build() and update() report files the Toker can't read
+* ver 1.2 : 19 Oct 2026
+* - per-file Tokers come from ScannerPool
+* ver 1.1 : 19 Oct 2026
+* - lines come from Toker offsets and a LineIndex
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace Scanner
+{
+  struct Posting
+  {
+    uint32_t file;   // index into the index's file table
+    uint32_t line;   // 1-based line number
+  };
+
+  class IdentIndex
+  {
+  public:
+    IdentIndex();
+    IdentIndex(const IdentIndex&) = delete;
+    IdentIndex& operator=(const IdentIndex&) = delete;
+    ~IdentIndex();
+    static bool build(const std::vector<std::string>& files, const std::string& indexPath, size_t nThreads = 0,
+      std::vector<size_t>* pUnreadable = nullptr);
+    bool open(const std::string& indexPath);
+    void close();
+    bool update(const std::vector<std::string>& files, const std::string& indexPath, size_t nThreads = 0,
+      std::vector<size_t>* pUnreadable = nullptr);
+    std::vector<Posting> query(const std::string& ident) const;
+    std::vector<Posting> queryFile(const std::string& ident, uint32_t file) const;
+    size_t fileCount() const;
+    size_t termCount() const;
+    std::string fileName(uint32_t file) const;
+  private:
+    void* _pMapping;
+    const char* _base;
+    size_t _size;
+  };
+}
+#endif
@@ -0,0 +1,171 @@
+///////////////////////////////////////////////////////////////////////
+// LineIndex.cpp - resolve byte offsets to line and column on demand //
+// ver 1.0                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* Files are read in 64 KB chunks, so building an index never holds more
+* than one chunk of text.  Each chunk is compared against '\n' sixteen
+* bytes at a time; the set bits of the compare mask are the newlines.
+*
+* Build Process:
+* --------------
+* Required Files: LineIndex.h, LineIndex.cpp
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include "LineIndex.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LINEINDEX_SSE2
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+using namespace Scanner;
+
+namespace
+{
+  const size_t ChunkSize = 64 * 1024;
+
+#ifdef LINEINDEX_SSE2
+  inline unsigned lowestBit(unsigned mask)
+  {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+  }
+#endif
+}
+
+LineIndex::LineIndex() : _built(true), _size(0), _lastLine(0) {}
+
+//--remembers path; the file is read on the first query
+LineIndex::LineIndex(const std::string& path)
+  : _path(path), _built(false), _size(0), _lastLine(0) {}
+
+//--indexes text held in memory
+void LineIndex::assign(const char* text, size_t size)
+{
+  _path.clear();
+  _newlines.clear();
+  _lastLine = 0;
+  _size = size;
+  scan(text, size, 0);
+  _built = true;
+}
+
+void LineIndex::build() const
+{
+  if (_built)
+    return;
+  _built = true;
+  std::ifstream in(_path, std::ios::binary);
+  std::vector<char> chunk(ChunkSize);
+  while (in.good())
+  {
+    in.read(chunk.data(), chunk.size());
+    size_t got = static_cast<size_t>(in.gcount());
+    scan(chunk.data(), got, _size);
+    _size += got;
+  }
+}
+
+//--appends the offsets of the newlines in text, which starts at base
+void LineIndex::scan(const char* text, size_t size, size_t base) const
+{
+  size_t i = 0;
+#ifdef LINEINDEX_SSE2
+  const __m128i newline = _mm_set1_epi8('\n');
+  for (; i + 16 <= size; i += 16)
+  {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+    unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, newline)));
+    while (mask != 0)
+    {
+      _newlines.push_back(base + i + lowestBit(mask));
+      mask &= mask - 1;
+    }
+  }
+#endif
+  while (i < size)
+  {
+    const char* found = static_cast<const char*>(std::memchr(text + i, '\n', size - i));
+    if (found == nullptr)
+      break;
+    i = static_cast<size_t>(found - text);
+    _newlines.push_back(base + i);
+    ++i;
+  }
+}
+
+//--1-based line and column of offset; a newline belongs to the line it ends
+TextPos LineIndex::position(size_t offset) const
+{
+  build();
+  size_t k = _lastLine;   // newlines before offset, if the guess holds
+  auto fits = [&](size_t n) {
+    return (n == 0 || _newlines[n - 1] < offset) && (n == _newlines.size() || offset <= _newlines[n]);
+  };
+  if (!fits(k))
+  {
+    if (k < _newlines.size() && fits(k + 1))
+      ++k;
+    else
+      k = std::lower_bound(_newlines.begin(), _newlines.end(), offset) - _newlines.begin();
+  }
+  _lastLine = k;
+  size_t lineStart = (k == 0) ? 0 : _newlines[k - 1] + 1;
+  return TextPos{ k + 1, offset - lineStart + 1 };
+}
+
+size_t LineIndex::lineCount() const
+{
+  build();
+  bool partialLast = _size > 0 && (_newlines.empty() || _newlines.back() != _size - 1);
+  return _newlines.size() + (partialLast ? 1 : 0);
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_LINEINDEX
+
+int main()
+{
+  std::string text = "int a;\n\nvoid f()\n{\n  return;\n}";
+  LineIndex lines;
+  lines.assign(text.data(), text.size());
+  std::cout << "\n  <-----------Line Index------------> \n";
+  std::cout << "\n  " << lines.lineCount() << " lines";
+  for (size_t offset : { size_t(0), size_t(4), size_t(6), size_t(7), size_t(8), size_t(19), size_t(23), size_t(29) })
+  {
+    TextPos pos = lines.position(offset);
+    std::cout << "\n  offset " << offset << " -> " << pos.line << ":" << pos.column;
+  }
+
+  std::string fileSpec = "../Tokenizer/TokenizerTestFile.txt";
+  LineIndex fileLines(fileSpec);
+  std::cout << "\n\n  " << fileSpec << " has " << fileLines.lineCount() << " lines";
+  std::cout << "\n\n";
+  return 0;
+}
+#endif
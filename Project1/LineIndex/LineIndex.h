@@ -0,0 +1,76 @@
+#ifndef LINEINDEX_H
+#define LINEINDEX_H
+///////////////////////////////////////////////////////////////////////
+// LineIndex.h - resolve byte offsets to line and column on demand   //
+// ver 1.0                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* Toker does not count lines; it only reports the offset at which each
+* token starts (Toker::tokOffset).  This package provides a LineIndex
+* class that records where every newline of a file is and turns such
+* offsets into 1-based (line, column) positions by binary search, so
+* only the tokens that need a position pay for one.
+*
+* A LineIndex constructed from a path does not read the file until the
+* first position is asked for.  Newlines are located 16 bytes at a time
+* with SSE2 compares where available, otherwise with memchr.  Queries
+* made in increasing offset order are answered from the previous line
+* without a search.
+*
+* Offsets match bytes in the file when the tokenized stream was opened
+* in binary mode, which is what clients of this package do; Toker treats
+* '\r' as whitespace, so tokens are the same either way.
+*
+* Public Interface:
+* -----------------
+* LineIndex lines("Tokenizer.cpp");
+* TextPos pos = lines.position(toker.tokOffset());
+* std::cout << pos.line << ":" << pos.column;
+*
+* Build Process:
+* --------------
+* Required Files: LineIndex.h, LineIndex.cpp
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+
+#include <string>
+#include <vector>
+
+namespace Scanner
+{
+  struct TextPos
+  {
+    size_t line;     // 1-based
+    size_t column;   // 1-based, in bytes
+  };
+
+  class LineIndex
+  {
+  public:
+    LineIndex();
+    explicit LineIndex(const std::string& path);
+    void assign(const char* text, size_t size);
+    TextPos position(size_t offset) const;
+    size_t lineCount() const;
+  private:
+    void build() const;
+    void scan(const char* text, size_t size, size_t base) const;
+    std::string _path;
+    mutable bool _built;
+    mutable size_t _size;
+    mutable size_t _lastLine;
+    mutable std::vector<size_t> _newlines;   // offsets of every '\n'
+  };
+}
+#endif
@@ -0,0 +1,150 @@
+///////////////////////////////////////////////////////////////////////
+// ScannerPool.cpp - per-thread pool of ready Toker/SemiExp pairs    //
+// ver 1.1                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* acquire() pops an idle pair, or builds one if the pool is empty, and
+* resets its Toker and SemiExp onto the new stream.  The SemiExp is also
+* pointed back at its own Toker, with the standard rules and bodies not
+* skipped, so nothing a previous lease set, such as a TimedSource that
+* has since gone out of scope, reaches the next one.  Lease's destructor
+* pushes the pair back.  Pairs are never freed while the thread lives, so
+* a pool holds as many pairs as were ever leased at once on its thread.
+*
+* Build Process:
+* --------------
+* Required Files:
+*   ScannerPool.h, ScannerPool.cpp, SemiExp.h, SemiExp.cpp, SemiRules.h,
+*   SemiRules.cpp, Tokenizer.h, Tokenizer.cpp
+*
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 19 Oct 2026
+* - acquire() restores the SemiExp's source, rules and skip mode
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+#include <iostream>
+#include "ScannerPool.h"
+
+using namespace Scanner;
+
+//----< Lease >------------------------------------------------------
+
+ScannerPool::Lease::Lease(ScannerPool* pPool, std::unique_ptr<Entry> pEntry, bool attached)
+  : _pPool(pPool), _pEntry(std::move(pEntry)), _attached(attached) {}
+
+ScannerPool::Lease::Lease(Lease&& other)
+  : _pPool(other._pPool), _pEntry(std::move(other._pEntry)), _attached(other._attached) {}
+
+ScannerPool::Lease::~Lease()
+{
+  if (_pEntry != nullptr)
+    _pPool->release(std::move(_pEntry));
+}
+
+//----< ScannerPool >------------------------------------------------
+
+ScannerPool& ScannerPool::local()
+{
+  thread_local ScannerPool pool;
+  return pool;
+}
+
+ScannerPool::Lease ScannerPool::acquire(std::istream* pIn)
+{
+  return acquire(pIn, TokerConfig::defaults());
+}
+
+//--reuses an idle pair when there is one
+ScannerPool::Lease ScannerPool::acquire(std::istream* pIn, std::shared_ptr<const TokerConfig> config)
+{
+  std::unique_ptr<Entry> pEntry;
+  if (_idle.empty())
+    pEntry.reset(new Entry());
+  else
+  {
+    pEntry = std::move(_idle.back());
+    _idle.pop_back();
+  }
+  pEntry->toker.setConfig(config);
+  bool attached = pEntry->toker.reset(pIn);
+  pEntry->semi.reset();
+  pEntry->semi.setSource(&pEntry->toker);
+  pEntry->semi.setRules(SemiRules::standard());
+  pEntry->semi.setSkipBodies(false);
+  return Lease(this, std::move(pEntry), attached);
+}
+
+void ScannerPool::release(std::unique_ptr<Entry> pEntry)
+{
+  _idle.push_back(std::move(pEntry));
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_SCANNERPOOL
+
+#include <fstream>
+#include <sstream>
+#include <chrono>
+
+int main()
+{
+  std::cout << "\n  <-----------Scanner Pool------------> \n";
+  std::vector<std::string> files = {
+    "../Tokenizer/TokenizerTestFile.txt", "../SemiExp/SemiExpTestFile.txt", "../TestExec/ITokTestFile.txt"
+  };
+  for (auto& file : files)
+  {
+    std::ifstream in(file);
+    ScannerPool::Lease scanner = ScannerPool::local().acquire(&in);
+    if (!scanner.attached())
+    {
+      std::cout << "\n  can't open " << file;
+      continue;
+    }
+    size_t semis = 0;
+    while (scanner.semi().get())
+      ++semis;
+    std::cout << "\n  " << file << ": " << semis << " semi-expressions, "
+              << scanner.semi().lineCount() << " lines";
+  }
+  std::cout << "\n  idle pairs: " << ScannerPool::local().idle();
+
+  const size_t N = 100000;
+  std::string text = "int main() { return 0; }\n";
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < N; ++i)
+  {
+    std::istringstream in(text);
+    Toker toker;
+    toker.attach(&in);
+    SemiExp semi(&toker);
+    while (semi.get());
+  }
+  auto mid = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < N; ++i)
+  {
+    std::istringstream in(text);
+    ScannerPool::Lease scanner = ScannerPool::local().acquire(&in);
+    while (scanner.semi().get());
+  }
+  auto end = std::chrono::steady_clock::now();
+  typedef std::chrono::microseconds us;
+  std::cout << "\n\n  " << N << " tiny streams, new Toker each:  "
+            << std::chrono::duration_cast<us>(mid - start).count() / 1000 << " ms";
+  std::cout << "\n  " << N << " tiny streams, pooled:          "
+            << std::chrono::duration_cast<us>(end - mid).count() / 1000 << " ms";
+  std::cout << "\n\n";
+  return 0;
+}
+#endif
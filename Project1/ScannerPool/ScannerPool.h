@@ -0,0 +1,97 @@
+#ifndef SCANNERPOOL_H
+#define SCANNERPOOL_H
+///////////////////////////////////////////////////////////////////////
+// ScannerPool.h - per-thread pool of ready Toker/SemiExp pairs      //
+// ver 1.1                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* Constructing a Toker allocates its scanner states, and a SemiExp grows
+* its token vector as it is used.  For trees of many small files that
+* setup shows up in per-file time.  This package provides a ScannerPool
+* of Toker/SemiExp pairs that are reset onto each new stream instead of
+* being rebuilt.  Every lease starts from the same settings: the default
+* or given TokerConfig, and a SemiExp reading the pair's Toker with the
+* standard rules.
+*
+* ScannerPool::local() returns the calling thread's pool, so leases are
+* taken and returned without locking.  A Lease returns its pair to the
+* pool it came from when it is destroyed and must be destroyed on the
+* thread that acquired it.
+*
+* Public Interface:
+* -----------------
+* std::ifstream in(path);
+* ScannerPool::Lease scanner = ScannerPool::local().acquire(&in);
+* while (scanner.semi().get()) { ... }
+*
+* Build Process:
+* --------------
+* Required Files:
+*   ScannerPool.h, ScannerPool.cpp, SemiExp.h, SemiExp.cpp, SemiRules.h,
+*   SemiRules.cpp, Tokenizer.h, Tokenizer.cpp
+*
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 19 Oct 2026
+* - a lease no longer inherits the source, rules or skip mode that an
+*   earlier lease gave the SemiExp
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+
+#include <vector>
+#include <memory>
+#include <iosfwd>
+#include "../Tokenizer/Tokenizer.h"
+#include "../SemiExp/SemiExp.h"
+
+namespace Scanner
+{
+  class ScannerPool
+  {
+    struct Entry
+    {
+      Entry() : semi(&toker) {}
+      Toker toker;
+      SemiExp semi;
+    };
+  public:
+    class Lease
+    {
+    public:
+      Lease(Lease&& other);
+      Lease(const Lease&) = delete;
+      Lease& operator=(const Lease&) = delete;
+      ~Lease();
+      Toker& toker() { return _pEntry->toker; }
+      SemiExp& semi() { return _pEntry->semi; }
+      bool attached() const { return _attached; }   //false if the stream was not good
+    private:
+      friend class ScannerPool;
+      Lease(ScannerPool* pPool, std::unique_ptr<Entry> pEntry, bool attached);
+      ScannerPool* _pPool;
+      std::unique_ptr<Entry> _pEntry;
+      bool _attached;
+    };
+
+    ScannerPool() {}
+    ScannerPool(const ScannerPool&) = delete;
+    ScannerPool& operator=(const ScannerPool&) = delete;
+    static ScannerPool& local();
+    Lease acquire(std::istream* pIn);
+    Lease acquire(std::istream* pIn, std::shared_ptr<const TokerConfig> config);
+    size_t idle() const { return _idle.size(); }
+  private:
+    void release(std::unique_ptr<Entry> pEntry);
+    std::vector<std::unique_ptr<Entry>> _idle;
+  };
+}
+#endif
@@ -1,6 +1,6 @@
 ///////////////////////////////////////////////////////////////////////
 // SemiExpression.cpp - collect tokens for analysis                  //
-// ver 3.2                                                           //
+// ver 3.13                                                          //
 // Language:    C++, Visual Studio 2015                              //
 // Application: Parser component, CSE687 - Object Oriented Design    //
 // Source:      Jim Fawcett, Syracuse University, CST 4-187          //
@@ -24,12 +24,42 @@
 * Build Process:
 * --------------
 * Required Files:
-*   SemiExpression.h, SemiExpression.cpp, Tokenizer.h, Tokenizer.cpp
+*   SemiExpression.h, SemiExpression.cpp, SemiRules.h, SemiRules.cpp,
+*   Tokenizer.h, Tokenizer.cpp
 *
 * Build Command: devenv Project1.sln /rebuild debug
 *
 * Maintenance History:
 * --------------------
+* ver 3.13 : 19 Oct 2026
+* - setSkipBodies() skips the bodies of templates declared with class
+*   or a default argument in their template brackets
+* ver 3.12 : 19 Oct 2026
+* - get() joins the pieces of a token a capped source cut, so they are
+*   classified and their newlines counted as one token
+* ver 3.11 : 19 Oct 2026
+* - setSkipBodies(): after a semi-expression opening a function body,
+*   get() returns a placeholder for the body from the source's skipBlock()
+* ver 3.10 : 19 Oct 2026
+* - get() keeps its rules state when its source is cancelled, and the
+*   next get() goes on with the same semi-expression
+* ver 3.9 : 19 Oct 2026
+* - added fingerprint(), hashed as get() collects the tokens
+* ver 3.8 : 19 Oct 2026
+* - get() runs the SemiRules transition table instead of comparing
+*   string states; the checkFor helpers are gone
+* - added setRules()
+* ver 3.7 : 19 Oct 2026
+* - added setSource()
+* ver 3.6 : 19 Oct 2026
+* - tokens come from an ITokSource
+* ver 3.5 : 19 Oct 2026
+* - added show(ITokSink&)
+* ver 3.4 : 19 Oct 2026
+* - added reset() so a SemiExp can be reused for another file
+* ver 3.3 : 19 Oct 2026
+* - added lineCount() so clients can track line numbers across get()
+* - fixed access to _tokens.back() when a semi-expression starts with ':'
 * ver 3.2 : 08 Feb 2016
 * - Implemented ITokCollection interface.
 * - added conditions for checking  comments, for, preprocessor directives
@@ -45,103 +75,211 @@
 #include <algorithm>
 #include <unordered_map>
 #include <exception>
+#include <sstream>
 #include "SemiExp.h"
 #include "../Tokenizer/Tokenizer.h"
 
 using namespace Scanner;
 
-SemiExp::SemiExp(Toker* pToker) : _pToker(pToker) {}
+namespace
+{
+  const uint64_t FingerprintSeed = 14695981039346656037ull;   // FNV-1a 64
+  const uint64_t FingerprintPrime = 1099511628211ull;
 
+  //--folds a token's bytes, then its length, into h; newlines are left
+  //  out, so re-wrapping a semi-expression keeps its fingerprint
+  inline uint64_t addToFingerprint(uint64_t h, const std::string& tok)
+  {
+    if (tok.size() == 1 && tok[0] == '\n')
+      return h;
+    for (char ch : tok)
+      h = (h ^ static_cast<unsigned char>(ch)) * FingerprintPrime;
+    return (h ^ tok.size()) * FingerprintPrime;
+  }
+}
+
+SemiExp::SemiExp(ITokSource* pSource)
+  : _pSource(pSource), _pRules(SemiRules::standard()), _lineCount(0),
+    _fingerprint(FingerprintSeed), _fingerprintStale(false), _cancelled(false), _state(0), _prev(0),
+    _skipBodies(false), _skipPending(false) {}
+
+//--groups tokens as the rules profile says; see SemiRules.h
 bool SemiExp::get(bool clear)
 {
-  if (_pToker == nullptr)
+  if (_pSource == nullptr)
     throw(std::logic_error("no Toker reference"));
-  std::string currentState = "";
-  _tokens.clear();
-  int semiColonCount = 0;
+  bool closed = false;
+  if (_skipPending && skipBody(closed))
+    return closed;
+  const SemiRules& rules = *_pRules;
+  size_t state = rules.start();
+  size_t prev = 0;
+  if (_cancelled)   // go on with the semi-expression the source stopped in
+  {
+    state = _state;
+    prev = _prev;
+    _cancelled = false;
+  }
+  else
+  {
+    _tokens.clear();
+    _fingerprint = FingerprintSeed;
+    _fingerprintStale = false;
+  }
   while (true)
   {
-	if (semiColonCount == 2)
-	{
-	  semiColonCount = 0;
-	  currentState = "FORISCLOSED";
-	}
-    std::string token = _pToker->getTok();
+    std::string token = _pSource->getTok();
+    while (token != "" && _pSource->tokContinues())
+    {
+      std::string rest = _pSource->getTok();
+      if (rest == "")
+        token.clear();   // cancelled inside the token; its pieces come again
+      else
+        token += rest;
+    }
     if (token == "")
+    {
+      if (_pSource->cancelled())
+      {
+        _cancelled = true;
+        _state = state;
+        _prev = prev;
+      }
       break;
-	if (token == ":")     //public, private, protected
+    }
+	countLines(token);
+	size_t kind = rules.kindOf(token);
+	const SemiRules::Step& step = rules.step(state, prev, kind);
+	state = step.next;
+	if (step.keep)
 	{
-		if ((_tokens.back() == "public") || (_tokens.back() == "private") || (_tokens.back() == "protected"))
-		{
-			_tokens.push_back(token);
-			return true;
-		}
+	  prev = rules.prevClass(kind);
+	  _fingerprint = addToFingerprint(_fingerprint, token);
+	  _tokens.push_back(std::move(token));
 	}
-	checkForSingleComment(token, currentState);
-	if (token == "#")  //process preprocessor directives
-		currentState = "PREPROCESSOR";
-	checkForQuotes(token, currentState);
-	if (token == "\n" && ((currentState == "PREPROCESSOR") || currentState == "FORISCLOSED" || currentState == "SINGLECOMMENT" || currentState == "QUOTES" ))
-		return true;
-	if (token == "for")
-		currentState = "FORISOPEN";
-    _tokens.push_back(token);     //pushing tokens however into _token vector
-	if (checkForMultiComments(token) == true)
-		return true;
-    if (token == "{") return true;
-	if (token == "}") return true;
-	if (token == ";;" && currentState == "FORISOPEN")
-		currentState = "FORISCLOSED";
-	if ((token == ";") && ((currentState == "FORISOPEN") && (semiColonCount < 2)))
+	if (step.end)
 	{
-		semiColonCount++;
-		continue;
+	  _skipPending = _skipBodies && opensBody();
+	  return true;
 	}
-	else if (token == ";")
-		return true;
   }
   return false;
 }
 
+//--true if the semi-expression just collected, ending in {, opens the
+//  body of a function: it holds a ( outside any brackets, no = outside
+//  them but operator=, does not start with #, and is not a class,
+//  namespace or enum head.  "b{" in a constructor's initializer list,
+//  name{ after , or :, is not a body either.  Template brackets before
+//  the ( count as brackets, so template <class T> heads a function
+bool SemiExp::opensBody()
+{
+  std::vector<const Token*> toks;
+  for (auto& token : _tokens)
+    if (token != "\n" && token.compare(0, 2, "//") != 0 && token.compare(0, 2, "/*") != 0)
+      toks.push_back(&token);
+  if (toks.size() < 2 || *toks.back() != "{" || *toks[0] == "#")
+    return false;
+  size_t n = toks.size();
+  if (n >= 3 && (*toks[n - 3] == "," || *toks[n - 3] == ":"))
+    return false;
+  bool paren = false;
+  int depth = 0, angles = 0;
+  for (size_t i = 0; i < n - 1; ++i)
+  {
+    const Token& tok = *toks[i];
+    bool afterOperator = i > 0 && *toks[i - 1] == "operator";
+    if (!paren && depth == 0 && !afterOperator && (tok == "<" || tok == ">" || tok == ">>"))
+      angles += tok == "<" ? 1 : (tok == ">" ? -1 : -2);
+    else if (tok == "(" || tok == "[")
+    {
+      if (tok == "(" && depth == 0)
+        paren = true;
+      ++depth;
+    }
+    else if (tok == ")" || tok == "]")
+      --depth;
+    else if (depth == 0 && angles <= 0 && tok == "=" && !afterOperator)
+      return false;
+    else if (!paren && angles <= 0 && (tok == "class" || tok == "struct" || tok == "union" ||
+      tok == "enum" || tok == "namespace" || tok == "extern"))
+      return false;
+  }
+  return paren;
+}
 
-void SemiExp :: checkForSingleComment(Token token, Token&currentState)
+//--the placeholder for a skipped body: "..." and the closing }, or
+//  just "..." if the source ended inside the body.  closed is false
+//  then, and when the source was cancelled, in which case the next get()
+//  tries again.  False if the source can't skip
+bool SemiExp::skipBody(bool& closed)
 {
-	try
-	{
-		//std::cout << "\n in checkforsinglecommenttokenis -> " << token<< "||";
-		if (token[0] == '/' && token[1] == '/')
-			currentState = "SINGLECOMMENT";
-	}
-	catch (std::exception e) {}
+  size_t newlines = 0;
+  if (!_pSource->skipBlock(newlines, closed))
+  {
+    _skipPending = false;
+    return false;
+  }
+  _tokens.clear();
+  _fingerprint = FingerprintSeed;
+  _fingerprintStale = false;
+  if (_pSource->cancelled())
+  {
+    _cancelled = true;
+    _state = _pRules->start();
+    _prev = 0;
+    return true;
+  }
+  _skipPending = false;
+  _cancelled = false;
+  _lineCount += newlines;
+  _tokens.push_back("...");
+  if (closed)
+    _tokens.push_back("}");
+  for (auto& token : _tokens)
+    _fingerprint = addToFingerprint(_fingerprint, token);
+  return true;
 }
 
-void SemiExp :: checkForQuotes(Token token, Token& currentState)
+//--keeps count of the newlines read so far, including those inside
+//  comment and quoted string tokens
+void SemiExp::countLines(const Token& token)
 {
-	try
-	{
-		if ((token[token.length() - 1] == '"' || token[token.length() - 1] == '\'') && (!(currentState == "SINGLECOMMENT") || !(currentState == "PREPROCESSOR")))
-			currentState = "QUOTES";
-	}
-	catch (std::exception e) {}
+	if (token == "\n")
+		++_lineCount;
+	else if (token[0] == '/' || token[0] == '"' || token[0] == '\'')
+		_lineCount += std::count(token.begin(), token.end(), '\n');
 }
 
-//--checks to see if closing symobol of multi-line comments has been encountered
-bool SemiExp :: checkForMultiComments(Token& token)
+//--64-bit hash of the tokens, newlines aside, the same in every run and
+//  on every platform; equal fingerprints mean, barring a 2^-64 chance,
+//  an unchanged semi-expression.  Kept up by get(); after push_back,
+//  remove and the like it is recomputed once, on the next call.  Writes
+//  through operator[] are not noticed
+uint64_t SemiExp::fingerprint()
 {
-	try
+	if (_fingerprintStale)
 	{
-		Token cToken = " " + token;
-		if ((cToken[cToken.length() - 1] == '/') && (cToken[cToken.length() - 2] == '*'))
-		{
-			//std::cout << "hello";
-			return true;
-		}
-		else
-			return false;
-		//std::cout << "Token after close -> " << token << " <-";
+		_fingerprint = FingerprintSeed;
+		for (auto& token : _tokens)
+			_fingerprint = addToFingerprint(_fingerprint, token);
+		_fingerprintStale = false;
 	}
-	catch (std::exception e) { return false; }
-	return false;
+	return _fingerprint;
+}
+
+//--true if the last get() stopped because its source was cancelled.
+//  The tokens so far are kept; resume the source and call get() again
+//  to finish the semi-expression
+bool SemiExp::cancelled()
+{
+	return _cancelled;
+}
+
+//--number of newlines consumed from the Toker by all calls to get()
+size_t SemiExp::lineCount()
+{
+	return _lineCount;
 }
 
 size_t SemiExp::length()
@@ -171,6 +309,7 @@ size_t SemiExp::find(const std::string& tok)
 void SemiExp::push_back(const std::string& tok)
 {
 	_tokens.push_back(tok);
+	_fingerprintStale = true;
 }
 
 bool SemiExp::merge(const std::string& firstTok, const std::string& secondTok)
@@ -184,17 +323,20 @@ bool SemiExp::remove(const std::string& tok)
 	if (index >= _tokens.size())
 		return false;
 	_tokens.erase(_tokens.begin() + index);
+	_fingerprintStale = true;
 	return true;
 }
 
 bool SemiExp::remove(size_t i)
 {
 	_tokens.erase(_tokens.begin() + i);
+	_fingerprintStale = true;
 	return true;
 }
 
 void SemiExp::toLower()
 {
+	_fingerprintStale = true;
 	for (int i = 0; i < (int)_tokens.size(); i++)
 		std::transform(_tokens[i].begin(), _tokens[i].end(), _tokens[i].begin(), tolower);
 }
@@ -217,6 +359,39 @@ void SemiExp::trimFront()
 void SemiExp::clear()
 {
 	_tokens.clear();
+	_fingerprintStale = true;
+}
+
+//--starts over on a Toker that has been reset onto a new stream
+void SemiExp::reset()
+{
+	_tokens.clear();
+	_cancelled = false;
+	_skipPending = false;
+	_fingerprintStale = true;
+	_lineCount = 0;
+}
+
+//--groups with another rules profile from the next get() on
+void SemiExp::setRules(std::shared_ptr<const SemiRules> pRules)
+{
+	if (pRules == nullptr)
+		throw(std::invalid_argument("no rules profile"));
+	_pRules = pRules;
+}
+
+//--declarations only: function bodies come back as "..." and }
+void SemiExp::setSkipBodies(bool value)
+{
+	_skipBodies = value;
+	if (!value)
+		_skipPending = false;
+}
+
+//--reads further tokens from another source; tokens and line count are kept
+void SemiExp::setSource(ITokSource* pSource)
+{
+	_pSource = pSource;
 }
 
 Token SemiExp::show(bool showNewLines)
@@ -232,6 +407,15 @@ Token SemiExp::show(bool showNewLines)
   return "";
 }
 
+//--writes the tokens as one record; a text sink prints what show() does
+void SemiExp::show(ITokSink& sink, bool showNewLines)
+{
+  for (auto& token : _tokens)
+    if (token != "\n" || showNewLines)
+      sink.token(token);
+  sink.endRecord();
+}
+
 #ifdef TEST_SEMIEXP
 int main()
 {
@@ -245,7 +429,9 @@ int main()
   }
   toker.attach(&in);
   toker.setSpecialSingleChars("/");
+  std::cout << "\n\n ::Special Single Character \'/\' added to the defaults.";
   toker.setSpecialCharPairs("/=");
+  std::cout << "\n\n ::Special Character Pair \"/=\" added to the defaults.";
   toker.setCollectComments(true);  //testing comments
   SemiExp semi(&toker);
   while(semi.get())
@@ -263,6 +449,53 @@ int main()
     semi.show();
     std::cout << "\n\n";
   }
+  //a Toker capped at 4 chars, which cuts the comments, string and
+  //identifiers below, must give the same semis and lineCount()
+  std::string capText =
+    "/* a block comment\n   over two lines */\n"
+    "int longIdentifier = 42;  // a trailing comment\n"
+    "const char* s = \"a long quoted string\";\n"
+    "#include <vector>\n"
+    "for (int i = 0; i < 10; ++i)\n  { call(\"x\\\ny\"); }\n";
+  std::string capSemis[2];
+  size_t capLines[2];
+  for (size_t cap = 0; cap < 2; ++cap)
+  {
+    std::shared_ptr<TokerConfig> config = std::make_shared<TokerConfig>();
+    config->setCollectComments(true);
+    config->setMaxTokenSize(cap * 4);
+    Toker capToker(config);
+    std::istringstream capIn(capText);
+    capToker.attach(&capIn);
+    SemiExp capSemi(&capToker);
+    while (capSemi.get() || capSemi.length() > 0)
+    {
+      for (size_t i = 0; i < capSemi.length(); ++i)
+        capSemis[cap] += capSemi[i] + " ";
+      capSemis[cap] += "| ";
+      capSemi.clear();
+    }
+    capLines[cap] = capSemi.lineCount();
+  }
+  std::cout << "\n ::Toker capped at 4 chars: " << capLines[1] << " lines, uncapped "
+    << capLines[0] << ", semis " << (capSemis[0] == capSemis[1] ? "same" : "DIFFERENT") << "\n";
+
+  //declarations only: both template forms are function heads, the
+  //class and the default template argument included
+  std::istringstream skipIn(
+    "template <class T> T f(T a) { return a + 1; }\n"
+    "template <typename T> T g(T a) { return a + 2; }\n"
+    "template <class T = int, typename U> struct S { T t; };\n"
+    "template <typename T = int> void h() { int x = 3; }\n");
+  Toker skipToker;
+  skipToker.attach(&skipIn);
+  SemiExp skipSemi(&skipToker);
+  skipSemi.setSkipBodies(true);
+  std::cout << "\n ::Bodies skipped:";
+  while (skipSemi.get())
+    skipSemi.show();
+  std::cout << "\n";
+
   //testing the remaining functions of ITok Interface
   semi.clear();
   semi.push_back("\n");
@@ -2,7 +2,7 @@
 #define SEMIEXPRESSION_H
 ///////////////////////////////////////////////////////////////////////
 // SemiExpression.h - collect tokens for analysis                    //
-// ver 3.3                                                           //
+// ver 3.13                                                          //
 // Language:    C++, Visual Studio 2015                              //
 // Application: Parser component, CSE687 - Object Oriented Design    //
 // Source:      Jim Fawcett, Syracuse University, CST 4-187          //
@@ -14,23 +14,75 @@
 * Package Operations:
 * -------------------
 * This package provides a public SemiExp class that collects and makes
-* available sequences of tokens.  SemiExp uses the services of a Toker
-* class to acquire tokens.  Each call to SemiExp::get() returns a 
+* available sequences of tokens.  SemiExp uses the services of a Toker,
+* or any other ITokSource, to acquire tokens.  Each call to SemiExp::get() returns a 
 * sequence of tokens that ends in {, ;, etc. Conditions for handling 
 * for is taken care. The entire for gets returned as a single token 
 * The code also handles the preprocessor directives and displays them 
 * as a single token.
 *
+* Those rules live in a SemiRules profile, compiled to a transition
+* table; setRules() swaps the profile without touching get().
+*
+* fingerprint() is a 64-bit FNV-1a hash of the tokens, newlines left
+* out, folded in by get() as each token is collected.  It is the same
+* from run to run, so a client can cache results by fingerprint and
+* re-analyze only the semi-expressions whose fingerprints are new.
+*
+* When its source is cancelled (see Toker::setCancel), get() returns
+* false, keeping the tokens it had and its place in the rules; once the
+* source is resumed, the next get() completes that semi-expression.
+*
+* With setSkipBodies(true), a semi-expression that opens a function body
+* (it ends in {, has a parenthesized list and is not a class, namespace
+* or initializer) is followed by one placeholder, "..." and the closing
+* }, read by the source's skipBlock() without tokenizing the body.  The
+* other semi-expressions and lineCount() come out as they would without
+* skipping.  Indexers that only need declarations save most of the
+* tokenizing; sources that can't skip group bodies as usual.
+*
+* A token a capped source (see TokerConfig::setMaxTokenSize) returns in
+* pieces is joined before get() classifies it, so semi-expressions and
+* lineCount() are those of an uncapped source; the cap bounds the
+* Toker's memory but not a SemiExp's.
 *
 * Build Process:
 * --------------
 * Required Files: 
-*   SemiExpression.h, SemiExpression.cpp, Tokenizer.h, Tokenizer.cpp
+*   SemiExpression.h, SemiExpression.cpp, SemiRules.h, SemiRules.cpp,
+*   Tokenizer.h, Tokenizer.cpp
 * 
 * Build Command: devenv Project1.sln /rebuild debug
 *
 * Maintenance History:
 * --------------------
+* ver 3.13 : 19 Oct 2026
+* - get() joins the pieces of tokens cut by a capped source
+* ver 3.12 : 19 Oct 2026
+* - added setSkipBodies(), a declarations-only mode that passes over
+*   function bodies with ITokSource::skipBlock()
+* ver 3.11 : 19 Oct 2026
+* - added cancelled(): a get() whose source was cancelled returns false
+*   with the tokens so far, and the next get() carries on from there
+* ver 3.10 : 19 Oct 2026
+* - added fingerprint(), a 64-bit hash of the tokens computed as get()
+*   collects them, so clients can skip semi-expressions that have not
+*   changed since an earlier run
+* ver 3.9 : 19 Oct 2026
+* - the grouping rules are a SemiRules profile, standard() by default;
+*   setRules() swaps in another, e.g. SemiRules::caseLabels()
+* - removed checkForQuotes, checkForSingleComment, checkForMultiComments
+* ver 3.8 : 19 Oct 2026
+* - added setSource(), e.g. to put a timing wrapper around the Toker
+* ver 3.7 : 19 Oct 2026
+* - reads from an ITokSource rather than a Toker, so it can group tokens
+*   replayed from a TokBroadcast
+* ver 3.6 : 19 Oct 2026
+* - added show(ITokSink&), writing the semi-expression as one sink record
+* ver 3.5 : 19 Oct 2026
+* - added reset(), clears tokens and the line count
+* ver 3.4 : 19 Oct 2026
+* - added lineCount(), the number of newlines read by get() so far
 * ver 3.3 : 08 Feb 2016
 * - Implemented ITokCollection interface.
 * - Added functions to refactor the code in function get().
@@ -55,8 +107,11 @@
 */
 
 #include <vector>
+#include <cstdint>
 #include "../Tokenizer/Tokenizer.h" 
 #include "ITokCollection.h"
+#include "SemiRules.h"
+#include "../Sink/ITokSink.h"
 
 namespace Scanner
 {
@@ -65,13 +120,13 @@ namespace Scanner
   class SemiExp : public ITokCollection
   {
   public:
-    SemiExp(Toker* pToker = nullptr);
+    SemiExp(ITokSource* pSource = nullptr);
     SemiExp(const SemiExp&) = delete;
     SemiExp& operator=(const SemiExp&) = delete;
-	void checkForQuotes(Token token, Token& currentState);
-	void checkForSingleComment(Token token, Token&currentState);
-	bool checkForMultiComments(Token& token);
     bool get(bool clear = true);
+	size_t lineCount();
+	uint64_t fingerprint();
+	bool cancelled();
 	size_t length();
     Token& operator[](int n);
 	size_t find(const std::string& tok);
@@ -82,10 +137,27 @@ namespace Scanner
 	void toLower();
 	void trimFront();
 	void clear();
+	void reset();
+	void setSource(ITokSource* pSource);
+	void setRules(std::shared_ptr<const SemiRules> pRules);
+	void setSkipBodies(bool value);
 	Token show(bool showNewLines = false);
+	void show(ITokSink& sink, bool showNewLines = false);
   private:
+	void countLines(const Token& token);
+	bool opensBody();
+	bool skipBody(bool& closed);
     std::vector<Token> _tokens;
-    Toker* _pToker;
+    ITokSource* _pSource;
+    std::shared_ptr<const SemiRules> _pRules;
+    size_t _lineCount;
+    uint64_t _fingerprint;
+    bool _fingerprintStale;
+    bool _cancelled;
+    size_t _state;     // grouping state kept over a cancelled get()
+    size_t _prev;
+    bool _skipBodies;
+    bool _skipPending;   // the last semi-expression opened a body to skip
   };
 }
 #endif
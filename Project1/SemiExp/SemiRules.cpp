@@ -0,0 +1,350 @@
+///////////////////////////////////////////////////////////////////////
+// SemiRules.cpp - semi-expression termination rules as a state     //
+//                 table                                             //
+// ver 1.0                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* The SemiRules constructor checks the profile, throwing
+* std::invalid_argument for rules it can't compile, then fills the
+* table by running the rules for every state, previous-token class and
+* kind.  A kind is a text index times TestBits plus the bits of the
+* character tests the token passes; text 0 is any token no rule names.
+* kindOf() looks a token up only if it is no longer than the longest
+* rule text, so most identifiers cost just the character tests.
+*
+* Build Process:
+* --------------
+* Required Files: SemiRules.h, SemiRules.cpp
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+
+#include <algorithm>
+#include <stdexcept>
+#include "SemiRules.h"
+
+using namespace Scanner;
+
+namespace
+{
+  const size_t TestBits = 8;   // one bit per character test
+
+  size_t testBit(TokTest test)
+  {
+    return size_t(1) << (static_cast<int>(test) - 1);
+  }
+
+  size_t nameIndex(std::vector<std::string>& names, const std::string& name)
+  {
+    auto it = std::find(names.begin(), names.end(), name);
+    if (it != names.end())
+      return it - names.begin();
+    names.push_back(name);
+    return names.size() - 1;
+  }
+
+  //--a rule with its names replaced by indices
+  struct Compiled
+  {
+    const SemiRule* pRule;
+    std::vector<bool> texts;     // by text index
+    std::vector<bool> in;        // by state; empty for any
+    std::vector<bool> notIn;
+    int prevSet;                 // -1 for any previous token
+    size_t state;
+  };
+
+  std::vector<bool> stateSet(std::vector<std::string>& names, const std::vector<std::string>& states)
+  {
+    std::vector<size_t> ids;
+    for (auto& name : states)
+      ids.push_back(nameIndex(names, name));
+    std::vector<bool> set;
+    for (size_t id : ids)
+    {
+      if (set.size() <= id)
+        set.resize(id + 1);
+      set[id] = true;
+    }
+    return set;
+  }
+
+  bool contains(const std::vector<bool>& set, size_t i)
+  {
+    return i < set.size() && set[i];
+  }
+
+  bool matches(const Compiled& rule, size_t state, size_t prev, size_t text, size_t tests)
+  {
+    if (rule.pRule->kind == TokTest::Text ? !contains(rule.texts, text) : (tests & testBit(rule.pRule->kind)) == 0)
+      return false;
+    if (rule.pRule->inStates.size() > 0 && !contains(rule.in, state))
+      return false;
+    if (contains(rule.notIn, state))
+      return false;
+    return rule.prevSet < 0 || (prev & (size_t(1) << rule.prevSet)) != 0;
+  }
+}
+
+//----< rule factories >-----------------------------------------------
+
+SemiRule SemiRule::text(const std::vector<std::string>& texts)
+{
+  SemiRule rule = test(TokTest::Text);
+  rule.texts = texts;
+  return rule;
+}
+
+SemiRule SemiRule::test(TokTest test)
+{
+  SemiRule rule;
+  rule.kind = test;
+  rule.afterPush = false;
+  rule.action = RuleAction::SetState;
+  rule.limit = 0;
+  return rule;
+}
+
+SemiRule& SemiRule::setState(const std::string& name)
+{
+  action = RuleAction::SetState;
+  state = name;
+  return *this;
+}
+
+SemiRule& SemiRule::count(size_t limit, const std::string& name)
+{
+  action = RuleAction::Count;
+  this->limit = limit;
+  state = name;
+  return *this;
+}
+
+//----< compiles the rules into the transition table >-----------------
+
+size_t SemiRules::textIndex(const std::string& text)
+{
+  size_t& id = _texts[text];
+  if (id == 0)
+    id = _texts.size();
+  _maxText = std::max(_maxText, text.size());
+  return id;
+}
+
+SemiRules::SemiRules(const std::vector<SemiRule>& rules) : _maxText(0)
+{
+  std::vector<std::string> names(1, "");
+  std::vector<std::vector<size_t>> prevSets;
+  std::vector<Compiled> compiled;
+  size_t limit = 1;
+  for (auto& rule : rules)
+  {
+    if (rule.kind == TokTest::Text && rule.texts.empty())
+      throw std::invalid_argument("text rule without texts");
+    if (rule.action == RuleAction::Drop && rule.afterPush)
+      throw std::invalid_argument("drop rule after the token was added");
+    if (rule.action == RuleAction::Count)
+    {
+      if (!rule.afterPush || rule.limit == 0 || (limit > 1 && rule.limit != limit))
+        throw std::invalid_argument("count rules must run after() and share one limit");
+      limit = rule.limit;
+    }
+    Compiled c;
+    c.pRule = &rule;
+    for (auto& text : rule.texts)
+    {
+      size_t id = textIndex(text);
+      if (c.texts.size() <= id)
+        c.texts.resize(id + 1);
+      c.texts[id] = true;
+    }
+    c.in = stateSet(names, rule.inStates);
+    c.notIn = stateSet(names, rule.notInStates);
+    c.state = nameIndex(names, rule.state);
+    c.prevSet = -1;
+    if (rule.prevTexts.size() > 0)
+    {
+      std::vector<size_t> set;
+      for (auto& text : rule.prevTexts)
+        set.push_back(textIndex(text));
+      std::sort(set.begin(), set.end());
+      auto it = std::find(prevSets.begin(), prevSets.end(), set);
+      c.prevSet = static_cast<int>(it - prevSets.begin());
+      if (it == prevSets.end())
+        prevSets.push_back(set);
+    }
+    compiled.push_back(c);
+  }
+  if (prevSets.size() > 8)
+    throw std::invalid_argument("more than eight distinct follows() lists");
+  _nStates = names.size() * limit;
+  if (_nStates > 0xffff)
+    throw std::invalid_argument("too many states");
+  _nPrev = size_t(1) << prevSets.size();
+  _nKinds = (_texts.size() + 1) * TestBits;
+
+  //--the previous-token class of a kind is the set of follows() lists
+  //  holding its text
+  _prevClass.assign(_nKinds, 0);
+  for (size_t kind = 0; kind < _nKinds; ++kind)
+    for (size_t j = 0; j < prevSets.size(); ++j)
+      if (std::binary_search(prevSets[j].begin(), prevSets[j].end(), kind / TestBits))
+        _prevClass[kind] |= size_t(1) << j;
+
+  //--runs the rules once for every state, previous class and kind
+  _table.resize(_nStates * _nPrev * _nKinds);
+  for (size_t state = 0; state < _nStates; ++state)
+    for (size_t prev = 0; prev < _nPrev; ++prev)
+      for (size_t kind = 0; kind < _nKinds; ++kind)
+      {
+        size_t name = state / limit, counter = state % limit;
+        size_t text = kind / TestBits, tests = kind % TestBits;
+        bool keep = true, end = false, stop = false;
+        for (int pass = 0; pass < 2 && !stop; ++pass)
+        {
+          for (auto& c : compiled)
+          {
+            if (c.pRule->afterPush != (pass == 1) || !matches(c, name, prev, text, tests))
+              continue;
+            if (c.pRule->action == RuleAction::SetState)
+            {
+              name = c.state;
+              continue;
+            }
+            if (c.pRule->action == RuleAction::Count && ++counter == limit)
+            {
+              name = c.state;
+              counter = 0;
+            }
+            keep = c.pRule->action != RuleAction::Drop;
+            end = c.pRule->action == RuleAction::End || c.pRule->action == RuleAction::Drop;
+            stop = true;
+            break;
+          }
+        }
+        Step& step = _table[(state * _nPrev + prev) * _nKinds + kind];
+        step.next = static_cast<unsigned short>(name * limit + counter);
+        step.keep = keep;
+        step.end = end;
+      }
+}
+
+//----< token kind: its rule text, if any, and the character tests >----
+
+size_t SemiRules::kindOf(const std::string& tok) const
+{
+  if (tok.empty())
+    return 0;
+  size_t text = 0;
+  if (tok.size() <= _maxText)
+  {
+    auto it = _texts.find(tok);
+    if (it != _texts.end())
+      text = it->second;
+  }
+  size_t tests = 0;
+  char last = tok.back();
+  if (tok[0] == '/' && tok[1] == '/')
+    tests |= testBit(TokTest::LineComment);
+  if (last == '"' || last == '\'')
+    tests |= testBit(TokTest::EndsInQuote);
+  if (tok.size() > 1 && last == '/' && tok[tok.size() - 2] == '*')
+    tests |= testBit(TokTest::EndsComment);
+  return text * TestBits + tests;
+}
+
+//----< profiles >-----------------------------------------------------
+
+//--the grouping SemiExp::get() has always done
+std::vector<SemiRule> SemiRules::standardRules()
+{
+  return {
+    SemiRule::text({ ":" }).follows({ "public", "protected", "private" }).end(),
+    SemiRule::test(TokTest::LineComment).setState("SINGLECOMMENT"),
+    SemiRule::text({ "#" }).setState("PREPROCESSOR"),
+    SemiRule::test(TokTest::EndsInQuote).setState("QUOTES"),
+    SemiRule::text({ "\n" }).in({ "PREPROCESSOR", "FORISCLOSED", "SINGLECOMMENT", "QUOTES" }).drop(),
+    SemiRule::text({ "for" }).setState("FORISOPEN"),
+    SemiRule::test(TokTest::EndsComment).after().end(),
+    SemiRule::text({ "{", "}" }).after().end(),
+    SemiRule::text({ ";;" }).in({ "FORISOPEN" }).after().setState("FORISCLOSED"),
+    SemiRule::text({ ";" }).in({ "FORISOPEN" }).after().count(2, "FORISCLOSED"),
+    SemiRule::text({ ";" }).after().end()
+  };
+}
+
+//--standard, with "case X:" and "default:" ending where the label does;
+//  a quoted label such as case 'a': must not leave the LABEL state
+std::vector<SemiRule> SemiRules::caseLabelRules()
+{
+  std::vector<SemiRule> rules = standardRules();
+  for (auto& rule : rules)
+    if (rule.kind == TokTest::EndsInQuote)
+      rule.unless({ "LABEL" });
+  rules.insert(rules.begin() + 1, {
+    SemiRule::text({ "case", "default" }).setState("LABEL"),
+    SemiRule::text({ ":" }).in({ "LABEL" }).end()
+  });
+  return rules;
+}
+
+std::shared_ptr<const SemiRules> SemiRules::standard()
+{
+  static std::shared_ptr<const SemiRules> pRules = std::make_shared<const SemiRules>(standardRules());
+  return pRules;
+}
+
+std::shared_ptr<const SemiRules> SemiRules::caseLabels()
+{
+  static std::shared_ptr<const SemiRules> pRules = std::make_shared<const SemiRules>(caseLabelRules());
+  return pRules;
+}
+
+//----< test stub >----------------------------------------------------
+
+#ifdef TEST_SEMIRULES
+#include <iostream>
+#include <sstream>
+#include "SemiExp.h"
+
+int main()
+{
+  std::cout << "\n  Testing SemiRules";
+  std::cout << "\n ===================\n";
+  std::string text =
+    "switch (c) {\n  case 'a': n = 1; break;\n  default: n = 0;\n}\n"
+    "for (int i = 0; i < 3; ++i) x += i;\n#include <map>\n";
+  std::shared_ptr<const SemiRules> profiles[] = { SemiRules::standard(), SemiRules::caseLabels() };
+  for (auto& pRules : profiles)
+  {
+    std::cout << "\n  " << pRules->states() << " states, " << pRules->kinds() << " token kinds";
+    std::istringstream in(text);
+    Toker toker;
+    toker.attach(&in);
+    SemiExp semi(&toker);
+    semi.setRules(pRules);
+    while (semi.get())
+      semi.show();
+    std::cout << "\n";
+  }
+  try
+  {
+    SemiRules bad({ SemiRule::text({ "x" }).after().drop() });
+  }
+  catch (std::invalid_argument& ex)
+  {
+    std::cout << "\n  rejected: " << ex.what() << "\n\n";
+  }
+  return 0;
+}
+#endif
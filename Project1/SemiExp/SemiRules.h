@@ -0,0 +1,130 @@
+#ifndef SEMIRULES_H
+#define SEMIRULES_H
+///////////////////////////////////////////////////////////////////////
+// SemiRules.h - semi-expression termination rules as a state table  //
+// ver 1.0                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package states when SemiExp::get() ends a semi-expression.  A
+* profile is a list of SemiRule, each one a test on the token, the
+* states it applies in, the token before it and an action.  For every
+* token, the rules marked before() are tried in order, the token is
+* added unless one of them dropped it, then the rules marked after()
+* are tried in order.  A SetState rule changes the state and goes on;
+* End ends the semi-expression (keeping the token), Drop ends it without
+* the token, and Count bumps a counter and skips the remaining rules,
+* moving to its state once the counter reaches its limit.  Every get()
+* starts in state "" with the counter at zero.
+*
+* SemiRules compiles a profile once.  Every distinct token text named by
+* the rules, combined with the three character tests, becomes a token
+* kind; every state name, paired with each counter value, becomes an
+* integer state.  The rules are run once for each state, previous token
+* and kind, and the outcome stored in a table, so get() does a hash
+* lookup and a few character tests per token and then only indexes.
+*
+* standard() is the grouping SemiExp has always done: for headers are
+* kept whole, preprocessor lines, line comments and lines holding quotes
+* end at the newline, and public:, protected: and private: stand alone.
+* caseLabels() adds "case X:" and "default:" as semi-expressions of
+* their own.
+*
+* Public Interface:
+* -----------------
+* std::vector<SemiRule> rules = SemiRules::standardRules();
+* rules.push_back(SemiRule::text({ "?" }).end());
+* SemiExp semi(&toker);
+* semi.setRules(std::make_shared<const SemiRules>(rules));
+*
+* size_t state = pRules->start(), prev = 0;
+* size_t kind = pRules->kindOf(tok);
+* const SemiRules::Step& step = pRules->step(state, prev, kind);
+*
+* Build Process:
+* --------------
+* Required Files: SemiRules.h, SemiRules.cpp
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+namespace Scanner
+{
+  enum class TokTest { Text, LineComment, EndsInQuote, EndsComment };
+  enum class RuleAction { SetState, End, Drop, Count };
+
+  struct SemiRule
+  {
+    static SemiRule text(const std::vector<std::string>& texts);
+    static SemiRule test(TokTest test);
+    SemiRule& in(const std::vector<std::string>& states) { inStates = states; return *this; }
+    SemiRule& unless(const std::vector<std::string>& states) { notInStates = states; return *this; }
+    SemiRule& follows(const std::vector<std::string>& texts) { prevTexts = texts; return *this; }
+    SemiRule& before() { afterPush = false; return *this; }
+    SemiRule& after() { afterPush = true; return *this; }
+    SemiRule& setState(const std::string& name);
+    SemiRule& end() { action = RuleAction::End; return *this; }
+    SemiRule& drop() { action = RuleAction::Drop; return *this; }
+    SemiRule& count(size_t limit, const std::string& name);
+
+    TokTest kind;
+    std::vector<std::string> texts;        // TokTest::Text: any one of these
+    std::vector<std::string> inStates;     // empty: any state
+    std::vector<std::string> notInStates;
+    std::vector<std::string> prevTexts;    // empty: any previous token, or none
+    bool afterPush;
+    RuleAction action;
+    std::string state;                     // SetState and Count
+    size_t limit;                          // Count
+  };
+
+  class SemiRules
+  {
+  public:
+    struct Step
+    {
+      unsigned short next;
+      bool keep;
+      bool end;
+    };
+    explicit SemiRules(const std::vector<SemiRule>& rules);  //invalid_argument if malformed
+    size_t start() const { return 0; }
+    size_t kindOf(const std::string& tok) const;
+    size_t prevClass(size_t kind) const { return _prevClass[kind]; }
+    const Step& step(size_t state, size_t prev, size_t kind) const
+    {
+      return _table[(state * _nPrev + prev) * _nKinds + kind];
+    }
+    size_t states() const { return _nStates; }
+    size_t kinds() const { return _nKinds; }
+
+    static std::vector<SemiRule> standardRules();
+    static std::vector<SemiRule> caseLabelRules();
+    static std::shared_ptr<const SemiRules> standard();
+    static std::shared_ptr<const SemiRules> caseLabels();
+  private:
+    size_t textIndex(const std::string& text);
+    std::unordered_map<std::string, size_t> _texts;   // text -> index + 1
+    size_t _maxText;
+    size_t _nStates;
+    size_t _nPrev;
+    size_t _nKinds;
+    std::vector<size_t> _prevClass;
+    std::vector<Step> _table;
+  };
+}
+#endif
@@ -0,0 +1,319 @@
+///////////////////////////////////////////////////////////////////////
+// SemiSplit.cpp - semi-expression boundaries of a whole token array //
+// ver 1.0                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* The constructor finds the classes.  A kind's signature is the
+* previous-token class it leaves plus every step the SemiRules table
+* gives it.  Kinds with the same signature share a class, and kinds
+* that are quiet in every state collapse into class 0.  Kinds quiet
+* only in the start state get the QuietAtStart bit.  At most 127
+* classes of each sort fit in a byte, or the constructor throws.
+*
+* split() steps the table only at the tokens nextActive() stops at.  A
+* run of quiet tokens leaves no previous-token class, so prev is reset
+* after any skip.  nextActive() tests sixteen classes at a time with
+* SSE2 where the compiler targets it, and one at a time elsewhere.
+*
+* Build Process:
+* --------------
+* Required Files:
+*   SemiSplit.h, SemiSplit.cpp, SemiRules.h, SemiRules.cpp
+*
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+
+#include <map>
+#include <algorithm>
+#include <stdexcept>
+#include "SemiSplit.h"
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SEMISPLIT_SSE2
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+using namespace Scanner;
+
+namespace
+{
+#ifdef SEMISPLIT_SSE2
+  inline unsigned lowestBit(unsigned mask)
+  {
+#ifdef _MSC_VER
+    unsigned long bit;
+    _BitScanForward(&bit, mask);
+    return bit;
+#else
+    return __builtin_ctz(mask);
+#endif
+  }
+#endif
+
+  //--true if kind, in state, is kept, changes nothing and leaves no
+  //  previous-token class behind, whatever the previous token was
+  bool quietIn(const SemiRules& rules, size_t state, size_t kind, size_t prevs)
+  {
+    if (rules.prevClass(kind) != 0)
+      return false;
+    for (size_t prev = 0; prev < prevs; ++prev)
+    {
+      const SemiRules::Step& step = rules.step(state, prev, kind);
+      if (step.next != state || !step.keep || step.end)
+        return false;
+    }
+    return true;
+  }
+}
+
+//----< classes: kinds the rules treat alike share one >---------------
+
+SemiSplit::SemiSplit(std::shared_ptr<const SemiRules> pRules) : _pRules(pRules)
+{
+  if (pRules == nullptr)
+    throw(std::invalid_argument("no rules profile"));
+  const SemiRules& rules = *pRules;
+  size_t prevs = 1;
+  for (size_t kind = 0; kind < rules.kinds(); ++kind)
+    prevs = std::max(prevs, rules.prevClass(kind) + 1);
+
+  //--a kind's signature is the class it leaves and every step it takes
+  std::map<std::vector<size_t>, uint8_t> classOf;
+  size_t atStart = 0, elsewhere = 0;
+  _classOfKind.assign(rules.kinds(), 0);
+  _kindOfClass.assign(1, 0);
+  for (size_t kind = 0; kind < rules.kinds(); ++kind)
+  {
+    bool quietAtStart = quietIn(rules, rules.start(), kind, prevs);
+    bool quiet = quietAtStart;
+    for (size_t state = 0; quiet && state < rules.states(); ++state)
+      quiet = quietIn(rules, state, kind, prevs);
+    if (quiet)
+      continue;
+    std::vector<size_t> signature(1, rules.prevClass(kind));
+    for (size_t state = 0; state < rules.states(); ++state)
+      for (size_t prev = 0; prev < prevs; ++prev)
+      {
+        const SemiRules::Step& step = rules.step(state, prev, kind);
+        signature.push_back(step.next * 4 + step.keep * 2 + step.end);
+      }
+    auto it = classOf.find(signature);
+    if (it == classOf.end())
+    {
+      size_t& used = quietAtStart ? elsewhere : atStart;
+      if (++used > 127)
+        throw(std::invalid_argument("rules distinguish too many token kinds for SemiSplit"));
+      uint8_t cls = static_cast<uint8_t>(quietAtStart ? (QuietAtStart | (used - 1)) : used);
+      it = classOf.insert(std::make_pair(signature, cls)).first;
+      if (_kindOfClass.size() <= cls)
+        _kindOfClass.resize(cls + 1, 0);
+      _kindOfClass[cls] = kind;
+    }
+    _classOfKind[kind] = it->second;
+  }
+  _classes = 1 + classOf.size();
+}
+
+void SemiSplit::classify(const std::vector<std::string>& toks, std::vector<uint8_t>& classes) const
+{
+  classes.resize(toks.size());
+  for (size_t i = 0; i < toks.size(); ++i)
+    classes[i] = classOf(toks[i]);
+}
+
+//----< first class at or after from that split() must step >---------
+//
+//  Class 0 is quiet everywhere; in the start state, so are the classes
+//  with the high bit set.  A 16-byte block is tested with two compares:
+//  bytes equal to zero, and, at the start, bytes with the top bit set.
+
+size_t SemiSplit::nextActive(const uint8_t* classes, size_t from, size_t count, bool atStart) const
+{
+  size_t i = from;
+#ifdef SEMISPLIT_SSE2
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + 16 <= count; i += 16)
+  {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(classes + i));
+    unsigned quiet = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, zero)));
+    if (atStart)
+      quiet |= static_cast<unsigned>(_mm_movemask_epi8(block));
+    unsigned active = ~quiet & 0xffff;
+    if (active != 0)
+      return i + lowestBit(active);
+  }
+#endif
+  for (; i < count; ++i)
+    if (classes[i] != 0 && !(atStart && (classes[i] & QuietAtStart)))
+      return i;
+  return count;
+}
+
+//----< ends of every semi-expression, as get() would return them >---
+
+void SemiSplit::split(const uint8_t* classes, size_t count, std::vector<size_t>& ends) const
+{
+  const SemiRules& rules = *_pRules;
+  ends.clear();
+  size_t state = rules.start(), prev = 0;
+  for (size_t i = nextActive(classes, 0, count, true); i < count; )
+  {
+    size_t kind = _kindOfClass[classes[i]];
+    const SemiRules::Step& step = rules.step(state, prev, kind);
+    state = step.next;
+    if (step.keep)
+      prev = rules.prevClass(kind);
+    if (step.end)
+    {
+      ends.push_back(i + 1);
+      state = rules.start();
+      prev = 0;
+    }
+    size_t next = nextActive(classes, i + 1, count, state == rules.start());
+    if (next > i + 1)
+      prev = 0;   // the quiet tokens skipped all leave no class behind
+    i = next;
+  }
+  if (ends.empty() || count > ends.back())
+    ends.push_back(count);
+}
+
+void SemiSplit::split(const std::vector<uint8_t>& classes, std::vector<size_t>& ends) const
+{
+  split(classes.data(), classes.size(), ends);
+}
+
+bool SemiSplit::simd()
+{
+#ifdef SEMISPLIT_SSE2
+  return true;
+#else
+  return false;
+#endif
+}
+
+//----< test stub >----------------------------------------------------
+
+#ifdef TEST_SEMISPLIT
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include "../SemiExp/SemiExp.h"
+#include "../Tokenizer/Tokenizer.h"
+
+namespace
+{
+  //--replays a token array to SemiExp, counting what it hands out
+  class VectorSource : public ITokSource
+  {
+  public:
+    VectorSource(const std::vector<std::string>& toks) : _toks(toks), _pos(0) {}
+    virtual std::string getTok() { return _pos < _toks.size() ? _toks[_pos++] : ""; }
+    virtual size_t tokOffset() { return 0; }
+    size_t taken() const { return _pos; }
+  private:
+    const std::vector<std::string>& _toks;
+    size_t _pos;
+  };
+
+  void group(const std::vector<std::string>& toks, std::shared_ptr<const SemiRules> pRules, std::vector<size_t>& ends)
+  {
+    VectorSource source(toks);
+    SemiExp semi(&source);
+    semi.setRules(pRules);
+    ends.clear();
+    bool more = true;
+    while (more)
+    {
+      more = semi.get();
+      if (ends.empty() || source.taken() > ends.back())
+        ends.push_back(source.taken());
+    }
+  }
+}
+
+int main()
+{
+  std::cout << "\n  Testing SemiSplit";
+  std::cout << "\n ===================\n";
+  std::cout << "\n  split() skips with " << (SemiSplit::simd() ? "SSE2" : "scalar code");
+
+  std::vector<std::string> toks;
+  for (auto file : { "../Tokenizer/Tokenizer.cpp", "../SemiExp/SemiExp.cpp", "../SemiExp/SemiRules.cpp", "SemiSplit.cpp" })
+  {
+    std::ifstream in(file);
+    Toker toker;
+    if (!in.good() || !toker.attach(&in))
+    {
+      std::cout << "\n  can't open " << file << "\n\n";
+      return 1;
+    }
+    for (std::string tok = toker.getTok(); tok != ""; tok = toker.getTok())
+      toks.push_back(tok);
+  }
+  std::vector<std::string> all;   // the files twenty times over
+  for (size_t i = 0; i < 20; ++i)
+    all.insert(all.end(), toks.begin(), toks.end());
+
+  using Clock = std::chrono::steady_clock;
+  auto us = [](Clock::time_point from) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - from).count();
+  };
+  std::shared_ptr<const SemiRules> profiles[] = { SemiRules::standard(), SemiRules::caseLabels() };
+  for (auto& pRules : profiles)
+  {
+    SemiSplit splitter(pRules);
+    std::vector<size_t> expected, ends;
+    std::vector<uint8_t> classes;
+    Clock::time_point start = Clock::now();
+    group(all, pRules, expected);
+    long long grouped = us(start);
+    start = Clock::now();
+    splitter.classify(all, classes);
+    long long classified = us(start);
+    start = Clock::now();
+    splitter.split(classes, ends);
+    long long split = us(start);
+    std::cout << "\n\n  " << (pRules == profiles[0] ? "standard" : "caseLabels") << " rules, "
+      << splitter.classes() << " classes, " << all.size() << " tokens, "
+      << ends.size() << " semi-expressions, " << (ends == expected ? "same ends" : "DIFFERENT ends");
+    std::cout << "\n    SemiExp::get(): " << grouped << " us, classify(): " << classified
+      << " us, split(): " << split << " us";
+  }
+
+  //--edge cases: nothing, only quiet tokens, a for header, a cut-off line
+  std::vector<std::vector<std::string>> cases = {
+    {}, { "\n", "\n" }, { "a", "b" }, { "for", "(", ";", ";", ")", "x", ";" },
+    { "#", "include", "<", "map", ">", "\n", "int", "x", ";" },
+    { "class", "C", "{", "public", ":", "int", "x", ";", "}", ";" }, { "#", "define", "A" }
+  };
+  size_t wrong = 0;
+  SemiSplit splitter;
+  for (auto& edge : cases)
+  {
+    std::vector<size_t> expected, ends;
+    std::vector<uint8_t> classes;
+    group(edge, SemiRules::standard(), expected);
+    splitter.classify(edge, classes);
+    splitter.split(classes, ends);
+    wrong += ends != expected;
+  }
+  std::cout << "\n\n  " << cases.size() << " edge cases, " << wrong << " wrong\n\n";
+  return 0;
+}
+#endif
@@ -0,0 +1,86 @@
+#ifndef SEMISPLIT_H
+#define SEMISPLIT_H
+///////////////////////////////////////////////////////////////////////
+// SemiSplit.h - semi-expression boundaries of a whole token array   //
+// ver 1.0                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* SemiExp::get() runs its rules once per token.  When a file is already
+* a token array, SemiSplit finds every semi-expression boundary in one
+* sweep instead, stopping only at the tokens that can matter.
+*
+* classify() turns each token into a one-byte class.  Token kinds that
+* the SemiRules table treats alike share a class, and class 0 is every
+* kind that, in any state, is kept and changes nothing: identifiers,
+* most punctuators, literals.  Kinds that matter only outside the start
+* state, such as the newline that ends a preprocessor line, get a class
+* with the high bit set.
+*
+* split() skips runs of class 0 sixteen bytes at a time with SSE2
+* compares, and in the start state skips the high-bit classes too, so
+* newlines between statements cost nothing.  The tokens it stops at go
+* through the same SemiRules table as get(), which takes care of for
+* (;;), preprocessor lines and access specifiers.  Where SSE2 is not
+* available the skipping is done a byte at a time.
+*
+* ends holds, for each semi-expression, the number of tokens get()
+* would have read by the time it returned it, dropped newlines included,
+* then the total if tokens are left over, as Differential compares them.
+*
+* Public Interface:
+* -----------------
+* SemiSplit splitter;                      // or SemiSplit(SemiRules::caseLabels())
+* std::vector<uint8_t> classes;
+* std::vector<size_t> ends;
+* splitter.classify(toks, classes);
+* splitter.split(classes, ends);
+* for (size_t s = 0, first = 0; s < ends.size(); first = ends[s++])
+*   use(toks.begin() + first, toks.begin() + ends[s]);
+*
+* Build Process:
+* --------------
+* Required Files:
+*   SemiSplit.h, SemiSplit.cpp, SemiRules.h, SemiRules.cpp
+*
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "../SemiExp/SemiRules.h"
+
+namespace Scanner
+{
+  class SemiSplit
+  {
+  public:
+    explicit SemiSplit(std::shared_ptr<const SemiRules> pRules = SemiRules::standard());  //invalid_argument if too many classes
+    uint8_t classOf(const std::string& tok) const { return _classOfKind[_pRules->kindOf(tok)]; }
+    void classify(const std::vector<std::string>& toks, std::vector<uint8_t>& classes) const;
+    void split(const uint8_t* classes, size_t count, std::vector<size_t>& ends) const;
+    void split(const std::vector<uint8_t>& classes, std::vector<size_t>& ends) const;
+    size_t classes() const { return _classes; }   //in use, class 0 included
+    static bool simd();   //true if split() skips with SSE2
+  private:
+    static const uint8_t QuietAtStart = 0x80;
+    size_t nextActive(const uint8_t* classes, size_t from, size_t count, bool atStart) const;
+    std::shared_ptr<const SemiRules> _pRules;
+    std::vector<uint8_t> _classOfKind;
+    std::vector<size_t> _kindOfClass;   // a kind of each class in use
+    size_t _classes;
+  };
+}
+#endif
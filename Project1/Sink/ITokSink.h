@@ -0,0 +1,39 @@
+#ifndef ITOKSINK_H
+#define ITOKSINK_H
+///////////////////////////////////////////////////////////////////////
+// ITokSink.h - interface for consumers of token output              //
+// ver 1.0                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Module Purpose:
+* ===============
+* ITokSink lets SemiExp::show() and the test drivers write tokens without
+* knowing where they go or how they are encoded.  Output is a sequence of
+* records, each a run of tokens closed by endRecord(); a semi-expression
+* is one record.  text() carries free-form, human-readable lines that
+* structured sinks may drop.
+*
+* Maintenance History:
+* ====================
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+
+#include <string>
+
+namespace Scanner
+{
+  struct ITokSink
+  {
+    virtual void text(const std::string& str) = 0;
+    virtual void token(const std::string& tok) = 0;
+    virtual void endRecord() = 0;
+    virtual void flush() = 0;
+    virtual ~ITokSink() {};
+  };
+}
+#endif
@@ -0,0 +1,386 @@
+///////////////////////////////////////////////////////////////////////
+// Sink.cpp - buffered token output in text, NDJSON or binary form   //
+// ver 1.1                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* Records are formatted straight into the buffer; flush() writes what has
+* accumulated with one write call, looping only if the system accepts a
+* partial write.  A token larger than the whole buffer is written
+* through directly after flushing what precedes it.
+*
+* Output written by a sink attached to stdout is not ordered with
+* std::cout; flush one before using the other.
+*
+* Build Process:
+* --------------
+* Required Files: Sink.h, Sink.cpp, ITokSink.h
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 19 Oct 2026
+* - added BinaryTokReader
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+#include <cstring>
+#include <algorithm>
+#include <fcntl.h>
+#ifdef _WIN32
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <unistd.h>
+#endif
+#include "Sink.h"
+
+using namespace Scanner;
+
+namespace
+{
+  int openForWrite(const std::string& path)
+  {
+#ifdef _WIN32
+    return _open(path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    return ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+  }
+
+  //--writes all of data, returns false on error
+  bool writeAll(int fd, const char* data, size_t size)
+  {
+    while (size > 0)
+    {
+#ifdef _WIN32
+      int done = _write(fd, data, static_cast<unsigned>(std::min(size, size_t(1) << 30)));
+#else
+      ssize_t done = ::write(fd, data, size);
+#endif
+      if (done <= 0)
+        return false;
+      data += done;
+      size -= static_cast<size_t>(done);
+    }
+    return true;
+  }
+
+  void closeFd(int fd)
+  {
+#ifdef _WIN32
+    _close(fd);
+#else
+    ::close(fd);
+#endif
+  }
+}
+
+BufferedSink::BufferedSink(SinkFormat format, size_t bufferSize)
+  : _buffer(std::max(bufferSize, size_t(64))), _used(0), _fd(-1), _owned(false),
+    _good(true), _inRecord(false), _written(0), _format(format) {}
+
+BufferedSink::~BufferedSink() { close(); }
+
+bool BufferedSink::open(const std::string& path)
+{
+  close();
+  int fd = openForWrite(path);
+  if (fd < 0)
+    return false;
+  _fd = fd;
+  _owned = true;
+  _good = true;
+  return true;
+}
+
+bool BufferedSink::attach(int fd)
+{
+  close();
+  if (fd < 0)
+    return false;
+  _fd = fd;
+  _owned = false;
+  _good = true;
+  return true;
+}
+
+//--flushes, and closes the file if open() created it
+void BufferedSink::close()
+{
+  if (_fd < 0)
+    return;
+  flush();
+  if (_owned)
+    closeFd(_fd);
+  _fd = -1;
+  _owned = false;
+}
+
+void BufferedSink::flush()
+{
+  if (_used == 0)
+    return;
+  if (_fd >= 0 && _good)
+    _good = writeAll(_fd, _buffer.data(), _used);
+  _written += _used;
+  _used = 0;
+}
+
+//----< formatting >-------------------------------------------------
+
+void BufferedSink::put(char ch)
+{
+  if (_used == _buffer.size())
+    flush();
+  _buffer[_used++] = ch;
+}
+
+void BufferedSink::put(const char* data, size_t size)
+{
+  if (_used + size > _buffer.size())
+  {
+    flush();
+    if (size > _buffer.size())
+    {
+      if (_fd >= 0 && _good)
+        _good = writeAll(_fd, data, size);
+      _written += size;
+      return;
+    }
+  }
+  std::memcpy(_buffer.data() + _used, data, size);
+  _used += size;
+}
+
+void BufferedSink::putLength(size_t size)
+{
+  do {
+    char byte = static_cast<char>(size & 0x7f);
+    size >>= 7;
+    put(size > 0 ? static_cast<char>(byte | 0x80) : byte);
+  } while (size > 0);
+}
+
+//--writes str as a quoted JSON string
+void BufferedSink::putJson(const std::string& str)
+{
+  static const char hex[] = "0123456789abcdef";
+  put('"');
+  size_t start = 0;
+  for (size_t i = 0; i < str.size(); ++i)
+  {
+    unsigned char ch = static_cast<unsigned char>(str[i]);
+    if (ch >= 0x20 && ch != '"' && ch != '\\')
+      continue;
+    put(str.data() + start, i - start);
+    start = i + 1;
+    put('\\');
+    switch (ch)
+    {
+    case '"':  put('"'); break;
+    case '\\': put('\\'); break;
+    case '\n': put('n'); break;
+    case '\r': put('r'); break;
+    case '\t': put('t'); break;
+    default:
+      put("u00", 3);
+      put(hex[ch >> 4]);
+      put(hex[ch & 0xf]);
+    }
+  }
+  put(str.data() + start, str.size() - start);
+  put('"');
+}
+
+void BufferedSink::text(const std::string& str)
+{
+  if (_format == SinkFormat::Text)
+    put(str.data(), str.size());
+}
+
+void BufferedSink::token(const std::string& tok)
+{
+  switch (_format)
+  {
+  case SinkFormat::Text:
+    if (!_inRecord)
+      put("\n  ", 3);
+    put(tok.data(), tok.size());
+    put(' ');
+    break;
+  case SinkFormat::NDJson:
+    put(_inRecord ? ',' : '[');
+    putJson(tok);
+    break;
+  case SinkFormat::Binary:
+    putLength(tok.size());
+    put(tok.data(), tok.size());
+    break;
+  }
+  _inRecord = true;
+}
+
+void BufferedSink::endRecord()
+{
+  switch (_format)
+  {
+  case SinkFormat::Text:
+    if (!_inRecord)
+      put("\n  ", 3);
+    put('\n');
+    break;
+  case SinkFormat::NDJson:
+    if (!_inRecord)
+      put('[');
+    put("]\n", 2);
+    break;
+  case SinkFormat::Binary:
+    put('\0');
+    break;
+  }
+  _inRecord = false;
+}
+
+//----< BinaryTokReader >-------------------------------------------
+
+bool BinaryTokReader::next(std::vector<std::string>& record)
+{
+  record.clear();
+  while (_pos < _end)
+  {
+    size_t size = 0;
+    for (int shift = 0; ; shift += 7)
+    {
+      if (_pos == _end || shift > 63)
+        return false;
+      unsigned char byte = static_cast<unsigned char>(*_pos++);
+      size |= static_cast<size_t>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0)
+        break;
+    }
+    if (size == 0)
+      return true;
+    if (size > static_cast<size_t>(_end - _pos))
+      return false;
+    record.push_back(std::string(_pos, size));
+    _pos += size;
+  }
+  return false;
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_SINK
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <thread>
+#include "../Tokenizer/Tokenizer.h"
+
+using namespace std::chrono;
+
+//--writes every token of path to sink, one record per line of source
+void dumpTokens(const std::string& path, ITokSink& sink)
+{
+  std::ifstream in(path);
+  Toker toker;
+  if (!toker.attach(&in))
+    return;
+  while (true)
+  {
+    std::string tok = toker.getTok();
+    if (tok == "")
+      break;
+    if (tok == "\n")
+      sink.endRecord();
+    else
+      sink.token(tok);
+  }
+  sink.endRecord();
+}
+
+int main()
+{
+  std::cout << "\n  <-----------Buffered Sinks------------> \n";
+  std::vector<std::string> files = {
+    "../Tokenizer/Tokenizer.cpp", "../SemiExp/SemiExp.cpp", "../Sink/Sink.cpp"
+  };
+  const char* names[] = { "sink_text.txt", "sink_tokens.ndjson", "sink_tokens.bin" };
+  SinkFormat formats[] = { SinkFormat::Text, SinkFormat::NDJson, SinkFormat::Binary };
+
+  //--one thread and one sink per format
+  std::vector<std::thread> threads;
+  for (size_t f = 0; f < 3; ++f)
+    threads.push_back(std::thread([&, f]() {
+      BufferedSink sink(formats[f]);
+      if (!sink.open(names[f]))
+        return;
+      for (size_t rep = 0; rep < 200; ++rep)
+        for (auto& file : files)
+          dumpTokens(file, sink);
+    }));
+  for (auto& thrd : threads)
+    thrd.join();
+  for (auto name : names)
+  {
+    std::ifstream in(name, std::ios::binary | std::ios::ate);
+    std::cout << "\n  " << name << ": " << in.tellg() << " bytes";
+  }
+
+  std::ifstream json(names[1]);
+  std::string line;
+  for (int shown = 0; shown < 3 && std::getline(json, line); )
+    if (line != "[]")
+    {
+      std::cout << "\n  " << line;
+      ++shown;
+    }
+
+  //--formatted ofstream versus BufferedSink for the same text records
+  std::vector<std::string> toks;
+  {
+    std::ifstream in(files[0]);
+    Toker toker;
+    toker.attach(&in);
+    for (std::string tok = toker.getTok(); tok != ""; tok = toker.getTok())
+      toks.push_back(tok);
+  }
+  const size_t reps = 300;
+  auto start = steady_clock::now();
+  {
+    std::ofstream out("sink_bench.txt");
+    for (size_t rep = 0; rep < reps; ++rep)
+      for (auto& tok : toks)
+        out << "\n  " << tok << " " << "\n";
+  }
+  auto mid = steady_clock::now();
+  {
+    BufferedSink out;
+    out.open("sink_bench.txt");
+    for (size_t rep = 0; rep < reps; ++rep)
+      for (auto& tok : toks)
+      {
+        out.token(tok);
+        out.endRecord();
+      }
+  }
+  auto end = steady_clock::now();
+  std::cout << "\n\n  " << reps * toks.size() << " records, ofstream:     "
+            << duration_cast<milliseconds>(mid - start).count() << " ms";
+  std::cout << "\n  " << reps * toks.size() << " records, BufferedSink: "
+            << duration_cast<milliseconds>(end - mid).count() << " ms";
+  for (auto name : names)
+    std::remove(name);
+  std::remove("sink_bench.txt");
+  std::cout << "\n\n";
+  return 0;
+}
+#endif
@@ -0,0 +1,104 @@
+#ifndef SINK_H
+#define SINK_H
+///////////////////////////////////////////////////////////////////////
+// Sink.h - buffered token output in text, NDJSON or binary form     //
+// ver 1.1                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package provides a BufferedSink, an ITokSink that formats records
+* into one large buffer and hands each full buffer to the operating
+* system with a single write, bypassing iostream formatting and its
+* synchronization with stdio.  Three formats are supported:
+*   Text    - each record as SemiExp::show() prints it: "\n  tok tok \n";
+*             text() is copied through unchanged
+*   NDJson  - each record as one line holding a JSON array of strings
+*   Binary  - each token as a LEB128 length followed by its bytes, each
+*             record closed by a zero length (Toker never returns an
+*             empty token); text() is dropped here and in NDJson
+*
+* A BufferedSink takes no locks.  Give each thread its own sink, either
+* on its own file or on a shared descriptor opened for append, where
+* output interleaves only at buffer boundaries.
+*
+* Public Interface:
+* -----------------
+* BufferedSink out(SinkFormat::NDJson);
+* out.open("tokens.ndjson");       // or out.attach(1) for stdout
+* semi.show(out);
+* out.flush();                     // also done by the destructor
+*
+* BinaryTokReader reader(data, size);   // Binary output, e.g. mapped
+* std::vector<std::string> record;
+* while (reader.next(record)) { ... }
+*
+* Build Process:
+* --------------
+* Required Files: Sink.h, Sink.cpp, ITokSink.h
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 19 Oct 2026
+* - added BinaryTokReader, which decodes the Binary format
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+
+#include <string>
+#include <vector>
+#include "ITokSink.h"
+
+namespace Scanner
+{
+  enum class SinkFormat { Text, NDJson, Binary };
+
+  class BufferedSink : public ITokSink
+  {
+  public:
+    explicit BufferedSink(SinkFormat format = SinkFormat::Text, size_t bufferSize = 1 << 20);
+    BufferedSink(const BufferedSink&) = delete;
+    BufferedSink& operator=(const BufferedSink&) = delete;
+    ~BufferedSink();
+    bool open(const std::string& path);   //creates or truncates; sink closes it
+    bool attach(int fd);                  //e.g. 1 for stdout; caller keeps it
+    void close();
+    virtual void text(const std::string& str);
+    virtual void token(const std::string& tok);
+    virtual void endRecord();
+    virtual void flush();
+    bool good() const { return _good; }   //false after a failed write
+    size_t bytesWritten() const { return _written; }
+    SinkFormat format() const { return _format; }
+  private:
+    void put(const char* data, size_t size);
+    void put(char ch);
+    void putJson(const std::string& str);
+    void putLength(size_t size);
+    std::vector<char> _buffer;
+    size_t _used;
+    int _fd;
+    bool _owned;
+    bool _good;
+    bool _inRecord;
+    size_t _written;
+    SinkFormat _format;
+  };
+
+  //--reads records back from BufferedSink's Binary format
+  class BinaryTokReader
+  {
+  public:
+    BinaryTokReader(const char* data, size_t size) : _pos(data), _end(data + size) {}
+    bool next(std::vector<std::string>& record);   //false at end or on bad data
+  private:
+    const char* _pos;
+    const char* _end;
+  };
+}
+#endif
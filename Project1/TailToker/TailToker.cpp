@@ -0,0 +1,163 @@
+///////////////////////////////////////////////////////////////////////
+// TailToker.cpp - tokenize a growing file as data is appended       //
+// ver 1.0                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* Toker decides where a token ends from the character after it and, for
+* a few punctuators, one more, so a token is kept only if both of those
+* lie inside the file as it was when the poll began; otherwise it is
+* held back.  When a scan ends without another token, whatever
+* followed the last one (whitespace, or a comment when comments are not
+* collected) is scanned again next time, since an unterminated comment
+* looks the same as whitespace from outside the Toker.
+*
+* The file is reopened, in binary mode so offsets are bytes, on every
+* poll, which also picks up a file that was replaced by a longer one
+* with the same prefix.  A file that became shorter than the checkpoint,
+* or whose byte at the checkpoint changed, throws std::logic_error.
+*
+* Build Process:
+* --------------
+* Required Files: TailToker.h, TailToker.cpp, Tokenizer.h, Tokenizer.cpp
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include "TailToker.h"
+
+using namespace Scanner;
+
+TailToker::TailToker(const std::string& path, std::shared_ptr<const TokerConfig> config)
+  : _path(path), _toker(config), _cp(TokerCheckpoint{ 0, EOF }) {}
+
+//--continues from a checkpoint saved by an earlier TailToker
+void TailToker::resume(const TokerCheckpoint& cp)
+{
+  _cp = cp;
+}
+
+//--returns tokens completed since the last poll
+size_t TailToker::poll(std::vector<std::string>& toks, std::vector<size_t>* pOffsets)
+{
+  return scan(toks, pOffsets, false);
+}
+
+//--returns the rest of the file, including a token ending at its end
+size_t TailToker::finish(std::vector<std::string>& toks, std::vector<size_t>* pOffsets)
+{
+  return scan(toks, pOffsets, true);
+}
+
+size_t TailToker::scan(std::vector<std::string>& toks, std::vector<size_t>* pOffsets, bool final)
+{
+  std::ifstream in(_path, std::ios::binary);
+  if (!in.good())
+    return 0;
+  in.seekg(0, std::ios::end);
+  size_t size = static_cast<size_t>(in.tellg());
+  if (size < _cp.offset)
+    throw(std::logic_error("tailed file shrank: " + _path));
+  if (size == _cp.offset && _cp.lookahead == EOF)
+    return 0;
+  if (!_toker.resume(&in, _cp))
+    throw(std::logic_error("tailed file was rewritten: " + _path));
+
+  size_t count = 0;
+  while (true)
+  {
+    TokerCheckpoint before = _toker.checkpoint();
+    std::string tok = _toker.getTok();
+    if (tok == "")
+    {
+      _cp = final ? _toker.checkpoint() : before;
+      break;
+    }
+    TokerCheckpoint after = _toker.checkpoint();
+    if (!final && (after.lookahead == EOF || after.offset + 1 >= size))   // scanner saw the end
+    {
+      _cp = before;
+      break;
+    }
+    toks.push_back(tok);
+    if (pOffsets != nullptr)
+      pOffsets->push_back(_toker.tokOffset());
+    ++count;
+    _cp = after;
+  }
+  return count;
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_TAILTOKER
+
+#include <cstdio>
+
+int main()
+{
+  std::cout << "\n  <-----------Tail Mode Tokenizing------------> \n";
+  std::string source = "../Tokenizer/TokenizerTestFile.txt";
+  std::string growing = "tail_test.txt";
+  std::ifstream src(source, std::ios::binary);
+  std::string text((std::istreambuf_iterator<char>(src)), std::istreambuf_iterator<char>());
+
+  //--reference: the whole file in one pass
+  std::vector<std::string> whole;
+  {
+    std::ifstream in(source, std::ios::binary);
+    Toker toker;
+    toker.attach(&in);
+    for (std::string tok = toker.getTok(); tok != ""; tok = toker.getTok())
+      whole.push_back(tok);
+  }
+
+  //--append the same file in odd-sized pieces, polling after each,
+  //  and hand the checkpoint to a new TailToker half way through
+  std::remove(growing.c_str());
+  std::vector<std::string> tailed;
+  std::string saved;
+  size_t pos = 0;
+  {
+    TailToker tail(growing);
+    for (; pos < text.size() / 2; pos += 7)
+    {
+      std::ofstream out(growing, std::ios::binary | std::ios::app);
+      out << text.substr(pos, 7);
+      out.close();
+      tail.poll(tailed);
+    }
+    saved = tail.checkpoint().serialize();
+  }
+  std::cout << "\n  checkpoint after first half: " << saved;
+  TokerCheckpoint cp;
+  TokerCheckpoint::parse(saved, cp);
+  TailToker tail(growing);
+  tail.resume(cp);
+  for (; pos < text.size(); pos += 7)
+  {
+    std::ofstream out(growing, std::ios::binary | std::ios::app);
+    out << text.substr(pos, 7);
+    out.close();
+    tail.poll(tailed);
+  }
+  tail.finish(tailed);
+  std::remove(growing.c_str());
+
+  std::cout << "\n  one pass: " << whole.size() << " tokens, tailed: " << tailed.size() << " tokens, "
+            << (whole == tailed ? "identical" : "DIFFERENT");
+  std::cout << "\n\n";
+  return 0;
+}
+#endif
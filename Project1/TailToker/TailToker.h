@@ -0,0 +1,69 @@
+#ifndef TAILTOKER_H
+#define TAILTOKER_H
+///////////////////////////////////////////////////////////////////////
+// TailToker.h - tokenize a growing file as data is appended         //
+// ver 1.0                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package provides a TailToker, which follows a file that another
+* process is still writing.  Each poll() resumes a Toker from the last
+* checkpoint, so only bytes appended since then are scanned.
+*
+* A token that runs into the current end of the file may not be finished
+* ("ret" may become "return", an open comment may close later), so poll()
+* holds it back and keeps the checkpoint before it; it is scanned again,
+* with what follows, by the next poll.  finish() returns it once the
+* writer is done.
+*
+* checkpoint() can be serialized and handed to resume() in a later run,
+* to carry on tailing without rescanning the file.
+*
+* Public Interface:
+* -----------------
+* TailToker tail("generated.cpp");
+* std::vector<std::string> toks;
+* while (writing) { tail.poll(toks); ... }
+* tail.finish(toks);
+* std::string saved = tail.checkpoint().serialize();
+*
+* Build Process:
+* --------------
+* Required Files: TailToker.h, TailToker.cpp, Tokenizer.h, Tokenizer.cpp
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+
+#include <string>
+#include <vector>
+#include <memory>
+#include "../Tokenizer/Tokenizer.h"
+
+namespace Scanner
+{
+  class TailToker
+  {
+  public:
+    explicit TailToker(const std::string& path,
+      std::shared_ptr<const TokerConfig> config = TokerConfig::defaults());
+    void resume(const TokerCheckpoint& cp);
+    size_t poll(std::vector<std::string>& toks, std::vector<size_t>* pOffsets = nullptr);
+    size_t finish(std::vector<std::string>& toks, std::vector<size_t>* pOffsets = nullptr);
+    TokerCheckpoint checkpoint() const { return _cp; }
+  private:
+    size_t scan(std::vector<std::string>& toks, std::vector<size_t>* pOffsets, bool final);
+    std::string _path;
+    Toker _toker;
+    TokerCheckpoint _cp;
+  };
+}
+#endif
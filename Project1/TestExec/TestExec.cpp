@@ -6,7 +6,7 @@
 ///////////////////////////////////////////////////////////////////////
 // TestExec.cpp - demonstrates requirements for Tokenizer and        // 
 //                SemiExpression                                     //
-// ver 1.0                                                           //
+// ver 1.2                                                           //
 // Language:      C++, Visual Studio 2015                            //
 // Application:   Parser component, CSE687 - Object Oriented Design  //
 // Author:        Satish Goswami, Syracuse University                //
@@ -22,12 +22,16 @@
 * --------------
 * Required Files:
 *   TestExec.h, TestExec.cpp, SemiExpression.h, SemiExpression.cpp,
-*   Tokenizer.h, Tokenizer.cpp
+*   SemiRules.h, SemiRules.cpp, Tokenizer.h, Tokenizer.cpp, Sink.h, Sink.cpp
 *
 * Build Command: devenv Project1.sln /rebuild debug
 *
 * Maintenance History:
 * --------------------
+* ver 1.2 : 19 Oct 2026
+* - output written through a BufferedSink instead of std::cout
+* ver 1.1 : 19 Oct 2026
+* - prints the special character messages Toker no longer prints
 * ver 1.0 : 08 Feb 2016
 * - Made class and added functions to test Tokenizer and SemiExp
 *
@@ -35,35 +39,42 @@
 
 using namespace Scanner;
 
-TestExec :: TestExec(){}
+//--all demonstration output goes through one buffered sink on stdout
+TestExec :: TestExec()
+{
+	_out.attach(1);
+}
 
 void TestExec :: testTokenizer(Toker &toker, std::istream &in)
 {
 	toker.setCollectComments(true);
-	std::cout << "\n\n <-----------Tokenizer (Displaying Tokens)------------> \n";
+	_out.text("\n\n <-----------Tokenizer (Displaying Tokens)------------> \n");
 	toker.setSpecialSingleChars("@");      //Requirement 4 (appending to default special special character set)
+	_out.text("\n\n ::Special Single Character \'@\' added to the defaults.");
 	toker.setSpecialCharPairs("/=");
-	std::cout << "\n\n ::Function SetSpecialChars(ssc) & setSpecialCharPairs(scp) Implemented in Tokenizer.cpp and called in TestExec.cpp\n";
+	_out.text("\n\n ::Special Character Pair \"/=\" added to the defaults.");
+	_out.text("\n\n ::Function SetSpecialChars(ssc) & setSpecialCharPairs(scp) Implemented in Tokenizer.cpp and called in TestExec.cpp\n");
 	do
 	{
 		std::string tok = toker.getTok();
 		if (tok == "\n")
 			tok = "newline";
-		std::cout << "\n\n -- " << tok;
+		_out.text("\n\n -- " + tok);
 	} while (in.good());
 
-	std::cout << "\n\n";
+	_out.text("\n\n");
+	_out.flush();
 }
 
 void TestExec::testSemiExp(Toker& toker, std::istream& in)
 {
 	toker.setCollectComments(false);
-	std::cout << "\n\n <-----------SemiExpressions------------> \n";
+	_out.text("\n\n <-----------SemiExpressions------------> \n");
 	SemiExp semi(&toker);
 	while (semi.get())
 	{
-		std::cout << "\n  -- SemiExpression --";
-		semi.show();
+		_out.text("\n  -- SemiExpression --");
+		semi.show(_out);
 	}
 	/*
 	May have collected tokens, but reached end of stream
@@ -71,9 +82,9 @@ void TestExec::testSemiExp(Toker& toker, std::istream& in)
 	*/
 	if (semi.length() > 0)
 	{
-		std::cout << "\n  -- SemiExpression --";
-		semi.show();
-		std::cout << "\n\n";
+		_out.text("\n  -- SemiExpression --");
+		semi.show(_out);
+		_out.text("\n\n");
 	}
 	std::string fileSpecITok = "ITokTestFile.txt";
 
@@ -83,7 +94,8 @@ void TestExec::testSemiExp(Toker& toker, std::istream& in)
 	std::fstream inITok(fileSpecITok);
 	if (!inITok.good())
 	{
-		std::cout << "\n  can't open file " << fileSpecITok << "\n\n";
+		_out.text("\n  can't open file " + fileSpecITok + "\n\n");
+		_out.flush();
 		return;
 	}
 	t.attach(&inITok);
@@ -92,30 +104,31 @@ void TestExec::testSemiExp(Toker& toker, std::istream& in)
 
 void TestExec :: demonstrateRequirement9(SemiExp &semi, std::istream& in)
 {
-	std::cout << "\n\n\n <-----------ITokCollection Interface methods Implementation------------> \n";
+	_out.text("\n\n\n <-----------ITokCollection Interface methods Implementation------------> \n");
 	semi.clear();
 	semi.get();
 	int index = 2; std::string str = "itok";
 	//std::cout << "\n Testing ITokCollection Interface functions : \n";
-	std::cout << "\n\n - Token Vector contains : ";
-	semi.show(true);
+	_out.text("\n\n - Token Vector contains : ");
+	semi.show(_out, true);
 	semi.trimFront();
-	std::cout << "\n - Token Vector after trim contains : ";
-	semi.show();
+	_out.text("\n - Token Vector after trim contains : ");
+	semi.show(_out);
 	semi.toLower();
-	std::cout << "\n - Token Vector after toLower contains : ";
-	semi.show();
+	_out.text("\n - Token Vector after toLower contains : ");
+	semi.show(_out);
 	semi.remove(2);
-	std::cout << "\n - Token Vector after removing from position "<<index<<" contains : ";
-	semi.show();
+	_out.text("\n - Token Vector after removing from position " + std::to_string(index) + " contains : ");
+	semi.show(_out);
 	semi.remove("itok");  //uses find function
-	std::cout << "\n - Token Vector after removing \"" << str << "\" contains : ";
-	semi.show();
-	std::cout << "\n - Token at position " << index << " in Token Vector is : " << semi[index];
+	_out.text("\n - Token Vector after removing \"" + str + "\" contains : ");
+	semi.show(_out);
+	_out.text("\n - Token at position " + std::to_string(index) + " in Token Vector is : " + semi[index]);
 	semi.clear();
-	std::cout << "\n - Token Vector after clear() method contains : ";
-	semi.show();
-	std::cout << "\n\n";
+	_out.text("\n - Token Vector after clear() method contains : ");
+	semi.show(_out);
+	_out.text("\n\n");
+	_out.flush();
 }
 
 TestExec :: ~TestExec() {}
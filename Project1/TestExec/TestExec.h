@@ -3,7 +3,7 @@
 ///////////////////////////////////////////////////////////////////////
 // TestExec.h - demonstrates requirements for Tokenizer and          // 
 //              SemiExpression                                       //
-// ver 1.0                                                           //
+// ver 1.1                                                           //
 // Language:    C++, Visual Studio 2015                              //
 // Application: Parser component, CSE687 - Object Oriented Design    //
 // Author:      Satish Goswami, Syracuse University                  //
@@ -19,12 +19,14 @@
 * --------------
 * Required Files:
 *   TestExec.h, TestExec.cpp, SemiExpression.h, SemiExpression.cpp, 
-*   Tokenizer.h, Tokenizer.cpp
+*   SemiRules.h, SemiRules.cpp, Tokenizer.h, Tokenizer.cpp, Sink.h, Sink.cpp
 *
 * Build Command: devenv Project1.sln /rebuild debug
 *
 * Maintenance History:
 * --------------------
+* ver 1.1 : 19 Oct 2026
+* - added a BufferedSink for all demonstration output
 * ver 1.0 : 08 Feb 2016
 * - Made class and added functions to test Tokenizer and SemiExp 
 *
@@ -32,6 +34,7 @@
 
 #include "../Tokenizer/Tokenizer.h"
 #include "../SemiExp/SemiExp.h"
+#include "../Sink/Sink.h"
 
 namespace Scanner {
 
@@ -43,6 +46,8 @@ namespace Scanner {
 		void testSemiExp(Toker& toker, std::istream& in);
 		void demonstrateRequirement9(SemiExp &semi, std::istream& in);
 		~TestExec();
+	private:
+		BufferedSink _out;
 	};
 }
 #endif
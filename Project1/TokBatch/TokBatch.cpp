@@ -0,0 +1,344 @@
+///////////////////////////////////////////////////////////////////////
+// TokBatch.cpp - tokenize batches of small in-memory snippets       //
+// ver 1.2                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* A TokenBuffer's tokens are found by their ends: token i is the bytes
+* of _text from the end of token i - 1 to _ends[i], and _bounds holds
+* the first token of each snippet, with one more entry at the end.
+* Bracket partners are stored as signed distances, so append() copies
+* another buffer's partners unchanged after its tokens.
+*
+* scan() resets the one Toker onto each snippet in place.  When the Toker
+* throws, dropSnippet() truncates the buffer back to the snippet's first
+* token, so a worker's partial tokens never reach the merged result.
+* tokenize() keeps its worker TokBatches and their TokenBuffers between
+* batches, so threads after the first cost only their start-up.
+*
+* Build Process:
+* --------------
+* Required Files: TokBatch.h, TokBatch.cpp, Tokenizer.h, Tokenizer.cpp
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.2 : 19 Oct 2026
+* - scan() catches what the Toker throws and drops that snippet's tokens
+* ver 1.1 : 19 Oct 2026
+* - add() pairs brackets as they arrive, with matchBracket()
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+
+#include <thread>
+#include <algorithm>
+#include <stdexcept>
+#include "TokBatch.h"
+
+using namespace Scanner;
+
+//----< MemBuf >-----------------------------------------------------
+
+void MemBuf::assign(const char* data, size_t size)
+{
+  char* p = const_cast<char*>(data);
+  setg(p, p, p + size);
+}
+
+//----< TokenBuffer >------------------------------------------------
+
+//--empties the buffer, keeping its storage for the next batch
+void TokenBuffer::clear()
+{
+  _text.clear();
+  _ends.clear();
+  _offsets.clear();
+  _bounds.assign(1, 0);
+  _partners.clear();
+  _open.clear();
+  _unreadable.clear();
+}
+
+void TokenBuffer::setMatchBrackets(bool value)
+{
+  _matchBrackets = value;
+  clear();
+}
+
+size_t TokenBuffer::partner(size_t tok) const
+{
+  if (!_matchBrackets || _partners[tok] == 0)
+    return None;
+  return tok + _partners[tok];
+}
+
+//--pairs the bracket just added with an open one, or opens it
+void TokenBuffer::matchBracket(char ch)
+{
+  size_t tok = _ends.size() - 1;
+  char opener = ch == '}' ? '{' : ch == ')' ? '(' : ch == ']' ? '[' : 0;
+  if (opener == 0)
+  {
+    if (ch == '{' || ch == '(' || ch == '[')
+      _open.push_back(tok);
+    return;
+  }
+  size_t depth = _open.size();
+  while (depth > 0 && _text[start(_open[depth - 1])] != opener)
+    --depth;
+  if (depth == 0)
+    return;
+  size_t open = _open[depth - 1];
+  if (tok - open > INT32_MAX)
+    return;   // too far apart to record
+  _partners[open] = static_cast<int32_t>(tok - open);
+  _partners[tok] = -static_cast<int32_t>(tok - open);
+  _open.resize(depth - 1);
+}
+
+void TokenBuffer::add(const std::string& tok, size_t offset)
+{
+  _text.insert(_text.end(), tok.begin(), tok.end());
+  _ends.push_back(_text.size());
+  _offsets.push_back(static_cast<uint32_t>(offset));
+  if (_matchBrackets)
+  {
+    _partners.push_back(0);
+    if (tok.size() == 1)
+      matchBracket(tok[0]);
+  }
+}
+
+//--closes the current snippet; an empty snippet still gets a boundary
+void TokenBuffer::endSnippet()
+{
+  _bounds.push_back(_ends.size());
+  _open.clear();
+}
+
+//--brackets only pair within a snippet, so no partner is left dangling
+void TokenBuffer::dropSnippet()
+{
+  size_t first = _bounds.back();
+  _text.resize(start(first));
+  _ends.resize(first);
+  _offsets.resize(first);
+  if (_matchBrackets)
+    _partners.resize(first);
+  _open.clear();
+  _unreadable.push_back(snippets());
+}
+
+//--adds other's snippets after this buffer's own
+void TokenBuffer::append(const TokenBuffer& other)
+{
+  size_t textBase = _text.size(), tokBase = _ends.size(), snippetBase = snippets();
+  _text.insert(_text.end(), other._text.begin(), other._text.end());
+  for (size_t end : other._ends)
+    _ends.push_back(textBase + end);
+  _offsets.insert(_offsets.end(), other._offsets.begin(), other._offsets.end());
+  for (size_t i = 1; i < other._bounds.size(); ++i)
+    _bounds.push_back(tokBase + other._bounds[i]);
+  for (size_t snippet : other._unreadable)
+    _unreadable.push_back(snippetBase + snippet);
+  if (_matchBrackets)   // distances are relative, so they copy as they are
+  {
+    if (other._matchBrackets)
+      _partners.insert(_partners.end(), other._partners.begin(), other._partners.end());
+    else
+      _partners.resize(_ends.size(), 0);
+  }
+}
+
+//----< TokBatch >---------------------------------------------------
+
+TokBatch::TokBatch(std::shared_ptr<const TokerConfig> config)
+  : _config(config), _in(&_buf), _toker(config) {}
+
+//--one Toker, reset onto each snippet in turn
+void TokBatch::scan(const Snippet* snippets, size_t count, TokenBuffer& out)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (snippets[i].size > UINT32_MAX)
+      throw(std::invalid_argument("snippet larger than 4 GB"));
+    _buf.assign(snippets[i].data, snippets[i].size);
+    _in.clear();
+    try
+    {
+      if (snippets[i].size > 0 && _toker.reset(&_in))
+        for (std::string tok = _toker.getTok(); tok != ""; tok = _toker.getTok())
+          out.add(tok, _toker.tokOffset());
+    }
+    catch (std::exception&)   // bytes the Toker can't classify, such as a BOM
+    {
+      out.dropSnippet();
+    }
+    out.endSnippet();
+  }
+}
+
+void TokBatch::tokenize(const Snippet* snippets, size_t count, TokenBuffer& out, size_t nThreads)
+{
+  out.clear();
+  if (nThreads == 0)
+    nThreads = std::max(1u, std::thread::hardware_concurrency());
+  nThreads = std::max(size_t(1), std::min(nThreads, count));
+  if (nThreads == 1)
+  {
+    scan(snippets, count, out);
+    return;
+  }
+  while (_workers.size() < nThreads - 1)
+    _workers.emplace_back(new TokBatch(_config));
+  _parts.resize(nThreads - 1);
+
+  //--this thread takes the first run, straight into out
+  size_t run = count / nThreads, extra = count % nThreads;
+  std::vector<std::thread> threads;
+  size_t begin = run + (extra > 0 ? 1 : 0);
+  for (size_t t = 1; t < nThreads; ++t)
+  {
+    size_t size = run + (t < extra ? 1 : 0);
+    TokBatch* pWorker = _workers[t - 1].get();
+    TokenBuffer* pPart = &_parts[t - 1];
+    if (pPart->matchBrackets() != out.matchBrackets())
+      pPart->setMatchBrackets(out.matchBrackets());
+    const Snippet* pFirst = snippets + begin;
+    threads.push_back(std::thread([=]() { pPart->clear(); pWorker->scan(pFirst, size, *pPart); }));
+    begin += size;
+  }
+  scan(snippets, run + (extra > 0 ? 1 : 0), out);
+  for (auto& thrd : threads)
+    thrd.join();
+  for (size_t t = 0; t < nThreads - 1; ++t)
+    out.append(_parts[t]);
+}
+
+void TokBatch::tokenize(const std::vector<Snippet>& snippets, TokenBuffer& out, size_t nThreads)
+{
+  tokenize(snippets.data(), snippets.size(), out, nThreads);
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_TOKBATCH
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+
+int main()
+{
+  std::cout << "\n  <-----------Batch Tokenizing------------> \n";
+  std::ifstream file("../Tokenizer/Tokenizer.cpp");
+  std::stringstream text;
+  text << file.rdbuf();
+  std::string source = text.str();
+  if (source.size() < 1000)
+  {
+    std::cout << "\n  can't open ../Tokenizer/Tokenizer.cpp\n\n";
+    return 1;
+  }
+
+  //--50,000 snippets of 100 to 500 bytes cut from the source
+  std::vector<Snippet> batch;
+  size_t pos = 0;
+  for (size_t i = 0; i < 50000; ++i)
+  {
+    size_t size = 100 + (i * 7919) % 400;
+    if (pos + size > source.size())
+      pos = 0;
+    batch.push_back(Snippet{ source.data() + pos, size });
+    pos += size / 3 + 1;
+  }
+  std::string bom = "\xEF\xBB\xBFint x;\n";   // a UTF-8 byte order mark, which the Toker rejects
+  batch[37777] = Snippet{ bom.data(), bom.size() };
+
+  using Clock = std::chrono::steady_clock;
+  auto ms = [](Clock::time_point from) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - from).count();
+  };
+
+  //--one istringstream and one Toker per snippet, for comparison
+  Clock::time_point start = Clock::now();
+  TokenBuffer expected;
+  for (auto& snippet : batch)
+  {
+    std::istringstream in(std::string(snippet.data, snippet.size));
+    Toker toker;
+    try
+    {
+      toker.attach(&in);
+      for (std::string tok = toker.getTok(); tok != ""; tok = toker.getTok())
+        expected.add(tok, toker.tokOffset());
+    }
+    catch (std::exception&)
+    {
+      expected.dropSnippet();
+    }
+    expected.endSnippet();
+  }
+  std::cout << "\n  istringstream and Toker per snippet: " << ms(start) << " ms";
+
+  TokBatch batcher;
+  TokenBuffer result;
+  for (size_t nThreads : { 1, 1, 4 })
+  {
+    start = Clock::now();
+    batcher.tokenize(batch, result, nThreads);
+    long long elapsed = ms(start);
+    bool same = result.snippets() == expected.snippets() && result.tokens() == expected.tokens();
+    for (size_t s = 0; same && s < result.snippets(); ++s)
+      same = result.first(s) == expected.first(s);
+    for (size_t t = 0; same && t < result.tokens(); ++t)
+      same = result.str(t) == expected.str(t) && result.offset(t) == expected.offset(t);
+    same = same && result.unreadable() == expected.unreadable();
+    std::cout << "\n  TokBatch, " << nThreads << " thread(s): " << elapsed << " ms, "
+      << result.tokens() << " tokens, " << result.unreadable().size() << " unreadable, "
+      << (same ? "same tokens" : "DIFFERENT tokens");
+  }
+
+  //--bracket partners, checked against a scan with a stack of all kinds
+  result.setMatchBrackets(true);
+  start = Clock::now();
+  batcher.tokenize(batch, result, 4);
+  std::cout << "\n  TokBatch, 4 thread(s), brackets matched: " << ms(start) << " ms";
+  size_t pairs = 0, wrong = 0;
+  for (size_t s = 0; s < result.snippets(); ++s)
+  {
+    std::vector<size_t> open;
+    for (size_t t = result.first(s); t < result.last(s); ++t)
+    {
+      std::string tok = result.str(t);
+      if (tok == "{" || tok == "(" || tok == "[")
+        open.push_back(t);
+      else if (tok == "}" || tok == ")" || tok == "]")
+      {
+        char opener = tok == "}" ? '{' : tok == ")" ? '(' : '[';
+        size_t depth = open.size();
+        while (depth > 0 && *result.data(open[depth - 1]) != opener)
+          --depth;
+        size_t expect = depth > 0 ? open[depth - 1] : TokenBuffer::None;
+        if (depth > 0)
+          open.resize(depth - 1);
+        if (result.partner(t) != expect || (expect != TokenBuffer::None && result.partner(expect) != t))
+          ++wrong;
+        pairs += expect != TokenBuffer::None;
+      }
+    }
+    for (size_t t : open)
+      wrong += result.partner(t) != TokenBuffer::None;
+  }
+  std::cout << "\n  " << pairs << " bracket pairs, " << wrong << " wrong";
+  std::cout << "\n\n";
+  return 0;
+}
+#endif
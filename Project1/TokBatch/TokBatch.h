@@ -0,0 +1,150 @@
+#ifndef TOKBATCH_H
+#define TOKBATCH_H
+///////////////////////////////////////////////////////////////////////
+// TokBatch.h - tokenize batches of small in-memory snippets         //
+// ver 1.2                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* For snippets of a few hundred bytes, building an istringstream, which
+* copies the text, and a Toker for each one costs more than the scan.
+* TokBatch tokenizes a whole batch of (pointer, length) snippets with one
+* Toker, reset onto each snippet through a MemBuf that reads the caller's
+* bytes in place.
+*
+* Results go into a TokenBuffer: every token's bytes back to back in one
+* array, the end of each token, its offset within its snippet and the
+* first token of each snippet.  clear() keeps the capacity, so a buffer
+* passed to every batch stops allocating once it has grown to the size
+* of the largest batch.
+*
+* With setMatchBrackets(true), a TokenBuffer also keeps a stack of open
+* { ( [ tokens as they are added and records, for each bracket, the
+* distance to its partner in one int32 per token.  partner() is then a
+* single lookup, so skipping a body or argument list never scans.  A
+* closer pops back to the nearest opener of its own kind, leaving any
+* openers above it unmatched; a closer with no such opener, and openers
+* still open at the end of their snippet, have no partner.
+*
+* Given more than one thread, tokenize() splits the batch into that many
+* runs of consecutive snippets, tokenizes each on its own thread into its
+* own TokenBuffer and appends them in order.  The workers and their
+* buffers are kept for the next batch.
+*
+* A snippet holding bytes the Toker rejects, such as a UTF-8 byte order
+* mark, is kept in the buffer with no tokens and listed in unreadable(),
+* whichever thread scanned it.
+*
+* Public Interface:
+* -----------------
+* std::vector<Snippet> batch = { { text, size }, ... };
+* TokBatch toker;                        // or TokBatch(config)
+* TokenBuffer result;
+* toker.tokenize(batch, result);         // or (batch, result, 4) threads
+* for (size_t s = 0; s < result.snippets(); ++s)
+*   for (size_t t = result.first(s); t < result.last(s); ++t)
+*     use(result.data(t), result.size(t), result.offset(t));
+*
+* result.setMatchBrackets(true);         // before tokenize()
+* size_t close = result.partner(open);   // TokenBuffer::None if unmatched
+* for (size_t s : result.unreadable()) ...
+*
+* Build Process:
+* --------------
+* Required Files: TokBatch.h, TokBatch.cpp, Tokenizer.h, Tokenizer.cpp
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.2 : 19 Oct 2026
+* - a snippet the Toker throws on is left empty and listed in
+*   unreadable(), instead of ending the process from a worker thread
+* ver 1.1 : 19 Oct 2026
+* - TokenBuffer can match brackets as tokens are added
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <istream>
+#include <cstdint>
+#include "../Tokenizer/Tokenizer.h"
+
+namespace Scanner
+{
+  struct Snippet
+  {
+    const char* data;
+    size_t size;
+  };
+
+  //--reads a caller's bytes in place; they must outlive the reads
+  class MemBuf : public std::streambuf
+  {
+  public:
+    void assign(const char* data, size_t size);
+  };
+
+  class TokenBuffer
+  {
+  public:
+    static const size_t None = static_cast<size_t>(-1);
+    TokenBuffer() : _bounds(1, 0), _matchBrackets(false) {}
+    void setMatchBrackets(bool value);    //also clears the buffer
+    bool matchBrackets() const { return _matchBrackets; }
+    size_t partner(size_t tok) const;     //matching bracket, or None
+    size_t snippets() const { return _bounds.size() - 1; }
+    size_t tokens() const { return _ends.size(); }
+    size_t first(size_t snippet) const { return _bounds[snippet]; }     //first token
+    size_t last(size_t snippet) const { return _bounds[snippet + 1]; }  //one past
+    const char* data(size_t tok) const { return _text.data() + start(tok); }
+    size_t size(size_t tok) const { return _ends[tok] - start(tok); }
+    std::string str(size_t tok) const { return std::string(data(tok), size(tok)); }
+    size_t offset(size_t tok) const { return _offsets[tok]; }  //within its snippet
+    size_t bytes() const { return _text.size(); }
+    void clear();
+    void add(const std::string& tok, size_t offset);
+    void endSnippet();
+    void dropSnippet();   //discards the current snippet's tokens and marks it unreadable
+    const std::vector<size_t>& unreadable() const { return _unreadable; }   //in order
+    void append(const TokenBuffer& other);
+  private:
+    size_t start(size_t tok) const { return tok == 0 ? 0 : _ends[tok - 1]; }
+    void matchBracket(char ch);
+    std::vector<char> _text;
+    std::vector<size_t> _ends;
+    std::vector<uint32_t> _offsets;
+    std::vector<size_t> _bounds;      // first token of each snippet, then tokens()
+    bool _matchBrackets;
+    std::vector<int32_t> _partners;   // partner - token for brackets, else 0
+    std::vector<size_t> _open;        // unclosed openers in the current snippet
+    std::vector<size_t> _unreadable;  // snippets the Toker threw on
+  };
+
+  class TokBatch
+  {
+  public:
+    explicit TokBatch(std::shared_ptr<const TokerConfig> config = TokerConfig::defaults());
+    TokBatch(const TokBatch&) = delete;
+    TokBatch& operator=(const TokBatch&) = delete;
+    //--replaces out with the tokens of every snippet, in order
+    void tokenize(const Snippet* snippets, size_t count, TokenBuffer& out, size_t nThreads = 1);
+    void tokenize(const std::vector<Snippet>& snippets, TokenBuffer& out, size_t nThreads = 1);
+  private:
+    void scan(const Snippet* snippets, size_t count, TokenBuffer& out);
+    std::shared_ptr<const TokerConfig> _config;
+    MemBuf _buf;
+    std::istream _in;
+    Toker _toker;
+    std::vector<std::unique_ptr<TokBatch>> _workers;
+    std::vector<TokenBuffer> _parts;
+  };
+}
+#endif
@@ -0,0 +1,293 @@
+///////////////////////////////////////////////////////////////////////
+// TokBroadcast.cpp - scan a file once for several concurrent readers//
+// ver 1.1                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* Sequence numbers count tokens from the start of the stream; token n
+* lives in slot n % capacity.  A Reader takes at most a batch of
+* published tokens at a time and reads them without the lock.  It gives
+* them back, by advancing _released, only when it comes for the next
+* batch, so the slots it is reading cannot be reused under it.
+*
+* run() catches what the Toker throws and publishes done with _failed
+* set, so no Reader is left waiting on _readable for tokens that will
+* never come.
+*
+* Build Process:
+* --------------
+* Required Files:
+*   TokBroadcast.h, TokBroadcast.cpp, Tokenizer.h, Tokenizer.cpp,
+*   ITokSource.h
+*
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 19 Oct 2026
+* - run() publishes done when the Toker throws; slots keep tokContinues()
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <exception>
+#include "TokBroadcast.h"
+
+using namespace Scanner;
+
+namespace
+{
+  const size_t Closed = std::numeric_limits<size_t>::max();
+}
+
+TokBroadcast::TokBroadcast(size_t capacity, size_t batch)
+  : _ring(std::max<size_t>(capacity, 1)), _batch(std::max<size_t>(std::min(batch, capacity), 1)),
+    _written(0), _started(false), _done(false), _failed(false) {}
+
+//--a new reader of every token run() will scan
+TokBroadcast::Reader& TokBroadcast::subscribe()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_started)
+    throw(std::logic_error("TokBroadcast: subscribe after run"));
+  _readers.push_back(std::unique_ptr<Reader>(new Reader(*this)));
+  return *_readers.back();
+}
+
+//--first slot still held by some reader; call with _mutex held
+size_t TokBroadcast::slowest() const
+{
+  size_t result = _written;
+  for (auto& pReader : _readers)
+    result = std::min(result, pReader->_released);
+  return result;
+}
+
+void TokBroadcast::publish(size_t written, bool done, bool failed)
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _written = written;
+    _done = done;
+    _failed = failed;
+  }
+  _readable.notify_all();
+}
+
+bool TokBroadcast::failed()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _failed;
+}
+
+//--scans the stream into the ring until it ends or the Toker throws;
+//  returns the count of tokens published
+size_t TokBroadcast::run(std::istream* pIn, std::shared_ptr<const TokerConfig> config)
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_started)
+      throw(std::logic_error("TokBroadcast: run called twice"));
+    _started = true;
+  }
+  Toker toker(config);
+  if (!toker.attach(pIn))
+  {
+    publish(0, true);
+    return 0;
+  }
+  size_t capacity = _ring.size();
+  size_t seq = 0;
+  bool more = true;
+  while (more)
+  {
+    size_t room;
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _writable.wait(lock, [&]() { return seq - slowest() < capacity; });
+      room = std::min(capacity - (seq - slowest()), _batch);
+    }
+    size_t n = 0;
+    try
+    {
+      for (; n < room; ++n)
+      {
+        Slot& slot = _ring[(seq + n) % capacity];
+        slot.tok = toker.getTok();
+        if (slot.tok == "")
+        {
+          more = false;
+          break;
+        }
+        slot.offset = toker.tokOffset();
+        slot.continues = toker.tokContinues();
+      }
+    }
+    catch (std::exception&)
+    {
+      publish(seq + n, true, true);
+      return seq + n;
+    }
+    seq += n;
+    publish(seq, !more);
+  }
+  return seq;
+}
+
+//--next token, waiting for the scanner if it has not got that far
+std::string TokBroadcast::Reader::getTok()
+{
+  if (_pos == _limit)
+  {
+    std::unique_lock<std::mutex> lock(_owner._mutex);
+    if (_released == Closed)
+      return "";
+    _released = _pos;
+    _owner._writable.notify_one();
+    _owner._readable.wait(lock, [this]() { return _owner._written > _pos || _owner._done; });
+    _limit = std::min(_owner._written, _pos + _owner._batch);
+    if (_pos == _limit)
+      return "";
+  }
+  const Slot& slot = _owner._ring[_pos % _owner._ring.size()];
+  ++_pos;
+  _offset = slot.offset;
+  _continues = slot.continues;
+  return slot.tok;
+}
+
+bool TokBroadcast::Reader::failed()
+{
+  std::lock_guard<std::mutex> lock(_owner._mutex);
+  return _owner._failed;
+}
+
+void TokBroadcast::Reader::close()
+{
+  {
+    std::lock_guard<std::mutex> lock(_owner._mutex);
+    _released = Closed;
+    _limit = _pos;
+  }
+  _owner._writable.notify_one();
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_TOKBROADCAST
+
+#include <iostream>
+#include <fstream>
+#include <thread>
+#include "../SemiExp/SemiExp.h"
+
+using namespace Scanner;
+
+namespace
+{
+  std::vector<std::string> semis(SemiExp& semi)
+  {
+    std::vector<std::string> result;
+    while (semi.get())
+    {
+      std::string text;
+      for (size_t i = 0; i < semi.length(); ++i)
+        text += semi[i] + " ";
+      result.push_back(text);
+    }
+    return result;
+  }
+}
+
+int main()
+{
+  std::cout << "\n  <-----------One Scan, Several Readers------------> \n";
+  std::string path = "../Tokenizer/Tokenizer.cpp";
+
+  //--reference: each analysis scanning the file for itself
+  std::vector<std::string> directSemis;
+  std::vector<size_t> directOffsets;
+  {
+    std::ifstream in(path);
+    Toker toker;
+    toker.attach(&in);
+    SemiExp semi(&toker);
+    directSemis = semis(semi);
+  }
+  {
+    std::ifstream in(path);
+    Toker toker;
+    toker.attach(&in);
+    while (toker.getTok() != "")
+      directOffsets.push_back(toker.tokOffset());
+  }
+
+  //--the same analyses on one broadcast scan, with a small ring so the
+  //  scanner has to wait for its readers, and one reader that quits early
+  TokBroadcast broadcast(64, 16);
+  SemiExp semi(&broadcast.subscribe());
+  TokBroadcast::Reader& offsetReader = broadcast.subscribe();
+  TokBroadcast::Reader& quitter = broadcast.subscribe();
+  std::vector<std::string> sharedSemis;
+  std::vector<size_t> sharedOffsets;
+  size_t quitterCount = 0;
+  std::thread t1([&]() { sharedSemis = semis(semi); });
+  std::thread t2([&]() {
+    while (offsetReader.getTok() != "")
+      sharedOffsets.push_back(offsetReader.tokOffset());
+  });
+  std::thread t3([&]() {
+    while (quitterCount < 100 && quitter.getTok() != "")
+      ++quitterCount;
+    quitter.close();
+  });
+  std::ifstream in(path);
+  size_t scanned = broadcast.run(&in);
+  t1.join();
+  t2.join();
+  t3.join();
+
+  std::cout << "\n  scanned once: " << scanned << " tokens for " << broadcast.readers() << " readers";
+  std::cout << "\n  semi-expressions: " << sharedSemis.size() << ", "
+            << (sharedSemis == directSemis ? "same as direct scan" : "DIFFERENT");
+  std::cout << "\n  token offsets: " << sharedOffsets.size() << ", "
+            << (sharedOffsets == directOffsets ? "same as direct scan" : "DIFFERENT");
+  std::cout << "\n  early reader stopped after " << quitterCount << " tokens";
+
+  //--a Toker capped at 8 chars: the reader passes the pieces on as such
+  std::shared_ptr<TokerConfig> capped = std::make_shared<TokerConfig>();
+  capped->setMaxTokenSize(8);
+  TokBroadcast pieces;
+  SemiExp pieceSemi(&pieces.subscribe());
+  std::vector<std::string> pieceSemis;
+  std::thread t4([&]() { pieceSemis = semis(pieceSemi); });
+  std::ifstream pieceIn(path);
+  pieces.run(&pieceIn, capped);
+  t4.join();
+  std::cout << "\n  capped at 8 chars: " << pieceSemis.size() << " semi-expressions, "
+            << (pieceSemis == directSemis ? "same as direct scan" : "DIFFERENT");
+
+  //--a file the Toker throws on ends the stream instead of hanging
+  TokBroadcast bom;
+  TokBroadcast::Reader& bomReader = bom.subscribe();
+  size_t bomCount = 0;
+  std::thread t5([&]() {
+    while (bomReader.getTok() != "")
+      ++bomCount;
+  });
+  std::ifstream bomIn("../Tokenizer/BomTestFile.txt");
+  size_t bomScanned = bom.run(&bomIn);
+  t5.join();
+  std::cout << "\n  ../Tokenizer/BomTestFile.txt: " << bomScanned << " tokens, reader got "
+            << bomCount << ", " << (bom.failed() && bomReader.failed() ? "failed" : "NOT failed");
+  std::cout << "\n\n";
+  return 0;
+}
+#endif
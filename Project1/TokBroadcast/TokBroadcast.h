@@ -0,0 +1,125 @@
+#ifndef TOKBROADCAST_H
+#define TOKBROADCAST_H
+///////////////////////////////////////////////////////////////////////
+// TokBroadcast.h - scan a file once for several concurrent readers  //
+// ver 1.1                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* When several analyses look at the same file, each building its own
+* Toker scans every byte again.  A TokBroadcast scans the file once and
+* replays the tokens to any number of Readers, each an ITokSource, so
+* a SemiExp or any other consumer can be built on one.
+*
+* Tokens go into a fixed ring of slots.  run() scans on the calling
+* thread; each Reader is read on a thread of its own, at its own pace.
+* The scanner never overwrites a slot some Reader has not finished
+* with, so it runs at most one ring ahead of the slowest Reader, and
+* memory stays fixed however long the file is.  Readers and the scanner
+* meet under a lock only once per batch of tokens.
+*
+* If the Toker throws, on a byte it rejects such as a UTF-8 byte order
+* mark, run() publishes the tokens scanned so far and ends the stream
+* there: the Readers' getTok() returns "" and failed() is true, and so
+* is the broadcast's.  A config with a token size cap is honoured;
+* Readers pass tokContinues() along with each piece.
+*
+* A TokBroadcast serves one stream.  Every Reader must be subscribed
+* before run() starts, and a Reader that stops early must call close(),
+* or the scanner waits for it.
+*
+* Public Interface:
+* -----------------
+* TokBroadcast broadcast;
+* SemiExp semi(&broadcast.subscribe());
+* TokBroadcast::Reader& counter = broadcast.subscribe();
+* std::thread t1([&]() { while (semi.get()) { ... } });
+* std::thread t2([&]() { while (counter.getTok() != "") { ... } });
+* broadcast.run(&in);                    // failed() if the Toker gave up
+* t1.join(); t2.join();
+*
+* Build Process:
+* --------------
+* Required Files:
+*   TokBroadcast.h, TokBroadcast.cpp, Tokenizer.h, Tokenizer.cpp,
+*   ITokSource.h
+*
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 19 Oct 2026
+* - run() ends the stream, with failed() set, when the Toker throws,
+*   instead of leaving the Readers waiting for tokens forever
+* - Reader forwards tokContinues()
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <iosfwd>
+#include "../Tokenizer/Tokenizer.h"
+
+namespace Scanner
+{
+  class TokBroadcast
+  {
+  public:
+    class Reader : public ITokSource
+    {
+    public:
+      Reader(const Reader&) = delete;
+      Reader& operator=(const Reader&) = delete;
+      virtual std::string getTok();
+      virtual size_t tokOffset() { return _offset; }
+      virtual bool tokContinues() { return _continues; }
+      bool failed();  //the stream ended because the Toker threw
+      void close();   //reads no more; the scanner stops waiting for it
+    private:
+      friend class TokBroadcast;
+      Reader(TokBroadcast& owner) : _owner(owner), _pos(0), _limit(0), _released(0), _offset(0), _continues(false) {}
+      TokBroadcast& _owner;
+      size_t _pos;        // sequence number of the next token to read
+      size_t _limit;      // tokens this reader may read without locking
+      size_t _released;   // slots before this are free; guarded by _mutex
+      size_t _offset;
+      bool _continues;
+    };
+
+    explicit TokBroadcast(size_t capacity = 4096, size_t batch = 256);
+    TokBroadcast(const TokBroadcast&) = delete;
+    TokBroadcast& operator=(const TokBroadcast&) = delete;
+    Reader& subscribe();
+    size_t run(std::istream* pIn, std::shared_ptr<const TokerConfig> config = TokerConfig::defaults());
+    size_t readers() const { return _readers.size(); }
+    bool failed();   //run() stopped early because the Toker threw
+  private:
+    struct Slot
+    {
+      std::string tok;
+      size_t offset;
+      bool continues;
+    };
+    size_t slowest() const;
+    void publish(size_t written, bool done, bool failed = false);
+    std::vector<Slot> _ring;
+    size_t _batch;
+    std::vector<std::unique_ptr<Reader>> _readers;
+    std::mutex _mutex;
+    std::condition_variable _readable;
+    std::condition_variable _writable;
+    size_t _written;
+    bool _started;
+    bool _done;
+    bool _failed;
+  };
+}
+#endif
@@ -0,0 +1,575 @@
+///////////////////////////////////////////////////////////////////////
+// TokDaemon.cpp - cached tokenizing service over a Unix socket      //
+// ver 1.1                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* The server is one thread polling its listening socket, the inotify
+* descriptor, a wake-up pipe for stop(), and every connected client.
+* Requests are answered in the order they arrive.  Inotify events are
+* drained before any request is served, so a reply never comes from an
+* entry whose file is known to have changed.  The watch is added before
+* a file is scanned, so a change made during the scan is seen as well.
+*
+* Reply header: status (0 ok, 1 can't read file, 2 bad request), kind,
+* and result size, followed on success by the memfd as SCM_RIGHTS.
+*
+* Build Process:
+* --------------
+* Required Files:
+*   TokDaemon.h, TokDaemon.cpp, Sink.h, Sink.cpp, ScannerPool.h,
+*   ScannerPool.cpp, SemiExp.h, SemiExp.cpp, SemiRules.h, SemiRules.cpp,
+*   Tokenizer.h, Tokenizer.cpp
+*
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 19 Oct 2026
+* - a file the Toker throws on is answered as unreadable instead of
+*   ending the server, and its watch is removed
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+#include <fstream>
+#include <iostream>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+#include "TokDaemon.h"
+#include "../ScannerPool/ScannerPool.h"
+#ifdef __linux__
+#include <climits>
+#include <cstdlib>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/inotify.h>
+#endif
+
+using namespace Scanner;
+
+namespace
+{
+  struct Reply
+  {
+    uint32_t status;
+    uint32_t kind;
+    uint64_t size;
+  };
+  const uint32_t ReplyOk = 0;
+  const uint32_t ReplyUnreadable = 1;
+  const uint32_t ReplyBadRequest = 2;
+
+#ifdef __linux__
+  bool sockAddr(const std::string& path, sockaddr_un& addr)
+  {
+    if (path.size() >= sizeof(addr.sun_path))
+      return false;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strcpy(addr.sun_path, path.c_str());
+    return true;
+  }
+
+  //--sends reply, with fd attached when fd >= 0
+  bool sendReply(int sock, const Reply& reply, int fd)
+  {
+    iovec iov;
+    iov.iov_base = const_cast<Reply*>(&reply);
+    iov.iov_len = sizeof(reply);
+    msghdr msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    char control[CMSG_SPACE(sizeof(int))];
+    if (fd >= 0)
+    {
+      std::memset(control, 0, sizeof(control));
+      msg.msg_control = control;
+      msg.msg_controllen = sizeof(control);
+      cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+      cmsg->cmsg_level = SOL_SOCKET;
+      cmsg->cmsg_type = SCM_RIGHTS;
+      cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+      std::memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+    }
+    return sendmsg(sock, &msg, MSG_NOSIGNAL) == static_cast<ssize_t>(sizeof(reply));
+  }
+
+  //--receives a reply and the fd sent with it, -1 if none
+  bool recvReply(int sock, Reply& reply, int& fd)
+  {
+    fd = -1;
+    iovec iov;
+    iov.iov_base = &reply;
+    iov.iov_len = sizeof(reply);
+    msghdr msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    char control[CMSG_SPACE(sizeof(int))];
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    if (recvmsg(sock, &msg, MSG_CMSG_CLOEXEC) != static_cast<ssize_t>(sizeof(reply)))
+      return false;
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg))
+      if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS)
+        std::memcpy(&fd, CMSG_DATA(cmsg), sizeof(int));
+    return true;
+  }
+
+  //--scans path into a sealed memfd, returns -1 if path can't be read
+  //  or holds bytes the Toker rejects, such as a byte order mark
+  int scanToMemfd(char kind, const std::string& path, size_t& size)
+  {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.good())
+      return -1;
+    int fd = memfd_create("toker", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0)
+      return -1;
+    try
+    {
+      BufferedSink sink(SinkFormat::Binary);
+      sink.attach(fd);
+      ScannerPool::Lease scanner = ScannerPool::local().acquire(&in);
+      if (kind == 'T')
+      {
+        for (std::string tok = scanner.toker().getTok(); tok != ""; tok = scanner.toker().getTok())
+          sink.token(tok);
+        sink.endRecord();
+      }
+      else
+      {
+        SemiExp& semi = scanner.semi();
+        while (semi.get())
+          semi.show(sink);
+        if (semi.length() > 0)
+          semi.show(sink);
+      }
+      sink.close();
+      size = sink.bytesWritten();
+      if (!sink.good())
+      {
+        ::close(fd);
+        return -1;
+      }
+    }
+    catch (std::exception&)
+    {
+      ::close(fd);
+      return -1;
+    }
+    fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL);
+    return fd;
+  }
+#endif
+}
+
+//----< TokResult >--------------------------------------------------
+
+TokResult::TokResult() : _data(nullptr), _size(0), _reader(nullptr, 0) {}
+
+TokResult::~TokResult() { release(); }
+
+bool TokResult::next(std::vector<std::string>& record)
+{
+  return _reader.next(record);
+}
+
+void TokResult::release()
+{
+#ifdef __linux__
+  if (_data != nullptr)
+    munmap(const_cast<char*>(_data), _size);
+#endif
+  _data = nullptr;
+  _size = 0;
+  _reader = BinaryTokReader(nullptr, 0);
+}
+
+//----< TokServer >--------------------------------------------------
+
+TokServer::TokServer() : _listen(-1), _inotify(-1), _hits(0), _misses(0)
+{
+  _wake[0] = _wake[1] = -1;
+}
+
+TokServer::~TokServer()
+{
+#ifdef __linux__
+  for (auto& item : _cache)
+    ::close(item.second.memfd);
+  for (int fd : { _listen, _inotify, _wake[0], _wake[1] })
+    if (fd >= 0)
+      ::close(fd);
+  if (_listen >= 0)
+    unlink(_socketPath.c_str());
+#endif
+}
+
+//--binds socketPath, replacing a stale socket file left by a dead server
+bool TokServer::listen(const std::string& socketPath)
+{
+#ifdef __linux__
+  sockaddr_un addr;
+  if (_listen >= 0 || !sockAddr(socketPath, addr))
+    return false;
+  _listen = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  _inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (_listen < 0 || _inotify < 0 || pipe2(_wake, O_CLOEXEC | O_NONBLOCK) != 0)
+    return false;
+  unlink(socketPath.c_str());
+  if (bind(_listen, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(_listen, 64) != 0)
+  {
+    ::close(_listen);
+    _listen = -1;
+    return false;
+  }
+  _socketPath = socketPath;
+  return true;
+#else
+  (void)socketPath;
+  return false;
+#endif
+}
+
+void TokServer::stop()
+{
+#ifdef __linux__
+  if (_wake[1] >= 0)
+  {
+    char byte = 0;
+    ssize_t ignored = write(_wake[1], &byte, 1);
+    (void)ignored;
+  }
+#endif
+}
+
+void TokServer::run()
+{
+#ifdef __linux__
+  if (_listen < 0)
+    return;
+  std::map<int, std::string> clients;   // socket -> unfinished request text
+  while (true)
+  {
+    std::vector<pollfd> fds = { { _wake[0], POLLIN, 0 }, { _inotify, POLLIN, 0 }, { _listen, POLLIN, 0 } };
+    for (auto& client : clients)
+      fds.push_back(pollfd{ client.first, POLLIN, 0 });
+    if (poll(fds.data(), fds.size(), -1) < 0)
+      continue;
+    if (fds[0].revents != 0)
+      break;
+    drainWatches();
+    if (fds[2].revents & POLLIN)
+    {
+      int sock = accept4(_listen, nullptr, nullptr, SOCK_CLOEXEC);
+      if (sock >= 0)
+        clients[sock] = "";
+    }
+    for (size_t i = 3; i < fds.size(); ++i)
+    {
+      if (fds[i].revents == 0)
+        continue;
+      int sock = fds[i].fd;
+      char buffer[4096];
+      ssize_t got = read(sock, buffer, sizeof(buffer));
+      bool open = got > 0;
+      std::string& pending = clients[sock];
+      if (open)
+        pending.append(buffer, static_cast<size_t>(got));
+      size_t eol;
+      while (open && (eol = pending.find('\n')) != std::string::npos)
+      {
+        open = serve(sock, pending.substr(0, eol));
+        pending.erase(0, eol + 1);
+      }
+      if (!open)
+      {
+        ::close(sock);
+        clients.erase(sock);
+      }
+    }
+  }
+  for (auto& client : clients)
+    ::close(client.first);
+#endif
+}
+
+//--answers one request line; false if the client is gone
+bool TokServer::serve(int client, const std::string& request)
+{
+#ifdef __linux__
+  Reply reply = { ReplyBadRequest, 0, 0 };
+  if (request.size() < 3 || (request[0] != 'T' && request[0] != 'S') || request[1] != ' ')
+    return sendReply(client, reply, -1);
+  reply.kind = static_cast<uint32_t>(request[0]);
+  Entry* pEntry = lookup(request[0], request.substr(2));
+  if (pEntry == nullptr)
+  {
+    reply.status = ReplyUnreadable;
+    return sendReply(client, reply, -1);
+  }
+  reply.status = ReplyOk;
+  reply.size = pEntry->size;
+  return sendReply(client, reply, pEntry->memfd);
+#else
+  (void)client;
+  (void)request;
+  return false;
+#endif
+}
+
+//--returns the cached entry, scanning the file on a miss
+TokServer::Entry* TokServer::lookup(char kind, const std::string& path)
+{
+#ifdef __linux__
+  char real[PATH_MAX];
+  if (realpath(path.c_str(), real) == nullptr)
+    return nullptr;
+  std::string key = std::string(1, kind) + real;
+  auto iter = _cache.find(key);
+  if (iter != _cache.end())
+  {
+    ++_hits;
+    return &iter->second;
+  }
+  ++_misses;
+  int watch = inotify_add_watch(_inotify, real,
+    IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_MOVE_SELF | IN_DELETE_SELF);
+  if (watch < 0)
+    return nullptr;
+  size_t size = 0;
+  int memfd = scanToMemfd(kind, real, size);
+  if (memfd < 0)
+  {
+    bool shared = false;   // the other kind of result may hold the same watch
+    for (auto& item : _cache)
+      shared = shared || item.second.watch == watch;
+    if (!shared)
+      inotify_rm_watch(_inotify, watch);
+    return nullptr;
+  }
+  return &(_cache[key] = Entry{ memfd, size, watch });
+#else
+  (void)kind;
+  (void)path;
+  return nullptr;
+#endif
+}
+
+//--drops every entry of the file watched by watch
+void TokServer::invalidate(int watch)
+{
+#ifdef __linux__
+  bool found = false;
+  for (auto iter = _cache.begin(); iter != _cache.end(); )
+  {
+    if (iter->second.watch == watch)
+    {
+      ::close(iter->second.memfd);
+      iter = _cache.erase(iter);
+      found = true;
+    }
+    else
+      ++iter;
+  }
+  if (found)
+    inotify_rm_watch(_inotify, watch);
+#else
+  (void)watch;
+#endif
+}
+
+void TokServer::drainWatches()
+{
+#ifdef __linux__
+  alignas(inotify_event) char buffer[4096];
+  ssize_t got;
+  while ((got = read(_inotify, buffer, sizeof(buffer))) > 0)
+  {
+    for (char* p = buffer; p < buffer + got; )
+    {
+      inotify_event* event = reinterpret_cast<inotify_event*>(p);
+      invalidate(event->wd);
+      p += sizeof(inotify_event) + event->len;
+    }
+  }
+#endif
+}
+
+//----< TokClient >--------------------------------------------------
+
+TokClient::TokClient() : _socket(-1) {}
+
+TokClient::~TokClient() { close(); }
+
+bool TokClient::connect(const std::string& socketPath)
+{
+#ifdef __linux__
+  close();
+  sockaddr_un addr;
+  if (!sockAddr(socketPath, addr))
+    return false;
+  _socket = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (_socket < 0)
+    return false;
+  if (::connect(_socket, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+  {
+    close();
+    return false;
+  }
+  return true;
+#else
+  (void)socketPath;
+  return false;
+#endif
+}
+
+void TokClient::close()
+{
+#ifdef __linux__
+  if (_socket >= 0)
+    ::close(_socket);
+#endif
+  _socket = -1;
+}
+
+bool TokClient::tokens(const std::string& path, TokResult& result)
+{
+  return request('T', path, result);
+}
+
+bool TokClient::semis(const std::string& path, TokResult& result)
+{
+  return request('S', path, result);
+}
+
+bool TokClient::request(char kind, const std::string& path, TokResult& result)
+{
+  result.release();
+#ifdef __linux__
+  if (_socket < 0 || path.find('\n') != std::string::npos)
+    return false;
+  std::string line = std::string(1, kind) + " " + path + "\n";
+  if (send(_socket, line.data(), line.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(line.size()))
+    return false;
+  Reply reply;
+  int fd;
+  if (!recvReply(_socket, reply, fd))
+    return false;
+  if (reply.status != ReplyOk || fd < 0)
+  {
+    if (fd >= 0)
+      ::close(fd);
+    return false;
+  }
+  if (reply.size > 0)
+  {
+    void* addr = mmap(nullptr, static_cast<size_t>(reply.size), PROT_READ, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED)
+    {
+      ::close(fd);
+      return false;
+    }
+    result._data = static_cast<const char*>(addr);
+    result._size = static_cast<size_t>(reply.size);
+    result._reader = BinaryTokReader(result._data, result._size);
+  }
+  ::close(fd);
+  return true;
+#else
+  (void)kind;
+  (void)path;
+  return false;
+#endif
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_TOKDAEMON
+
+#include <thread>
+#include <chrono>
+
+using namespace std::chrono;
+
+int main()
+{
+  std::cout << "\n  <-----------Tokenizing Daemon------------> \n";
+  std::string socketPath = "/tmp/toker_test.sock";
+  TokServer server;
+  if (!server.listen(socketPath))
+  {
+    std::cout << "\n  can't listen on " << socketPath << "\n\n";
+    return 1;
+  }
+  std::thread daemon([&]() { server.run(); });
+
+  TokClient client;
+  if (!client.connect(socketPath))
+  {
+    std::cout << "\n  can't connect\n\n";
+    server.stop();
+    daemon.join();
+    return 1;
+  }
+  std::string file = "../Tokenizer/Tokenizer.cpp";
+  TokResult result;
+  std::vector<std::string> record;
+  for (int i = 0; i < 3; ++i)
+  {
+    auto start = steady_clock::now();
+    client.semis(file, result);
+    auto end = steady_clock::now();
+    size_t semis = 0;
+    while (result.next(record))
+      ++semis;
+    std::cout << "\n  " << file << ": " << semis << " semi-expressions, "
+              << result.size() << " bytes mapped in "
+              << duration_cast<microseconds>(end - start).count() << " us";
+  }
+  client.semis(file, result);
+  result.next(record);
+  std::cout << "\n  first:";
+  for (auto& tok : record)
+    std::cout << " " << tok;
+
+  //--a changed file is scanned again
+  std::string scratch = "daemon_test.txt";
+  std::ofstream(scratch) << "int x;\n";
+  client.tokens(scratch, result);
+  result.next(record);
+  std::cout << "\n\n  before change: " << record.size() << " tokens";
+  std::ofstream(scratch, std::ios::app) << "int y;\n";
+  client.tokens(scratch, result);
+  result.next(record);
+  std::cout << "\n  after change:  " << record.size() << " tokens";
+  std::remove(scratch.c_str());
+
+  //--a file the Toker rejects is unreadable and leaves the server running
+  std::string bom = "../Tokenizer/BomTestFile.txt";
+  bool got = client.tokens(bom, result);
+  std::cout << "\n  " << bom << ": " << (got ? "scanned" : "unreadable");
+  got = client.semis(file, result);
+  std::cout << "\n  " << file << " again: " << (got ? "scanned" : "not answered");
+
+  std::cout << "\n\n  cache hits " << server.hits() << ", misses " << server.misses();
+  result.release();
+  client.close();
+  server.stop();
+  daemon.join();
+  std::cout << "\n\n";
+  return 0;
+}
+#endif
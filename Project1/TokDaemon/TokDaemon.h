@@ -0,0 +1,139 @@
+#ifndef TOKDAEMON_H
+#define TOKDAEMON_H
+///////////////////////////////////////////////////////////////////////
+// TokDaemon.h - cached tokenizing service over a Unix socket        //
+// ver 1.1                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package provides a TokServer, a long-running process that
+* tokenizes files for other processes, and a TokClient they use to ask.
+*
+* A client sends one line per request, "T path" for the file's tokens or
+* "S path" for its semi-expressions.  The server answers with a short
+* reply header and, on success, passes a file descriptor for a sealed
+* memfd holding the result in BufferedSink's Binary format.  The client
+* maps it read-only, so results are never copied through the socket.
+* "T" results are one record holding every token, newlines included;
+* "S" results are one record per semi-expression.
+*
+* Results are cached in memory per path and kind.  Each cached file is
+* watched with inotify; any change to it drops its entries, so the next
+* request scans it again.  A cached result is shared, read-only, by
+* every client that maps it.  A file that can't be opened, or holds
+* bytes the Toker rejects such as a UTF-8 byte order mark, is answered
+* as unreadable and is neither cached nor watched.
+*
+* Unix domain sockets, memfd and inotify are Linux facilities; on other
+* platforms listen() and connect() return false.
+*
+* Public Interface:
+* -----------------
+* TokServer server;                         // in the daemon
+* server.listen("/tmp/toker.sock");
+* server.run();                             // until stop()
+*
+* TokClient client;                         // in each tool
+* client.connect("/tmp/toker.sock");
+* TokResult result;
+* if (client.semis("Tokenizer.cpp", result))
+*   while (result.next(record)) { ... }
+*
+* Build Process:
+* --------------
+* Required Files:
+*   TokDaemon.h, TokDaemon.cpp, Sink.h, Sink.cpp, ScannerPool.h,
+*   ScannerPool.cpp, SemiExp.h, SemiExp.cpp, SemiRules.h, SemiRules.cpp,
+*   Tokenizer.h, Tokenizer.cpp
+*
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 19 Oct 2026
+* - files the Toker throws on are answered as unreadable
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+
+#include <string>
+#include <vector>
+#include <map>
+#include <atomic>
+#include "../Sink/Sink.h"
+
+namespace Scanner
+{
+  //--a result mapped from the server's memfd
+  class TokResult
+  {
+  public:
+    TokResult();
+    TokResult(const TokResult&) = delete;
+    TokResult& operator=(const TokResult&) = delete;
+    ~TokResult();
+    bool next(std::vector<std::string>& record);
+    const char* data() const { return _data; }
+    size_t size() const { return _size; }
+    void release();
+  private:
+    friend class TokClient;
+    const char* _data;
+    size_t _size;
+    BinaryTokReader _reader;
+  };
+
+  class TokServer
+  {
+  public:
+    TokServer();
+    TokServer(const TokServer&) = delete;
+    TokServer& operator=(const TokServer&) = delete;
+    ~TokServer();
+    bool listen(const std::string& socketPath);
+    void run();          // serves until stop() is called
+    void stop();         // safe to call from any thread
+    size_t hits() const { return _hits; }
+    size_t misses() const { return _misses; }
+  private:
+    struct Entry
+    {
+      int memfd;
+      size_t size;
+      int watch;
+    };
+    bool serve(int client, const std::string& request);
+    Entry* lookup(char kind, const std::string& path);
+    void invalidate(int watch);
+    void drainWatches();
+    std::string _socketPath;
+    int _listen;
+    int _inotify;
+    int _wake[2];
+    std::map<std::string, Entry> _cache;     // kind + path
+    std::atomic<size_t> _hits;
+    std::atomic<size_t> _misses;
+  };
+
+  class TokClient
+  {
+  public:
+    TokClient();
+    TokClient(const TokClient&) = delete;
+    TokClient& operator=(const TokClient&) = delete;
+    ~TokClient();
+    bool connect(const std::string& socketPath);
+    bool tokens(const std::string& path, TokResult& result);
+    bool semis(const std::string& path, TokResult& result);
+    void close();
+  private:
+    bool request(char kind, const std::string& path, TokResult& result);
+    int _socket;
+  };
+}
+#endif
@@ -0,0 +1,469 @@
+///////////////////////////////////////////////////////////////////////
+// TokDiff.cpp - token-level diff of two versions of a file          //
+// ver 1.2                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* compare() marks each token that is not part of the common subsequence
+* instead of building an edit script, so subproblems can be solved in any
+* order.  They are kept on an explicit stack rather than by recursion,
+* since a large difference can split into very many of them.  bisect()
+* runs the forward and reverse searches of Myers' algorithm toward each
+* other and returns a point where they meet; both halves are strictly
+* smaller, so the loop ends.  Its two diagonal arrays are allocated once,
+* for the whole files, and reused by every subproblem.
+*
+* A bisect() that has searched MinDistance edits, or the square root of
+* its subproblem's size if that is more, without the two searches
+* meeting splits at the point either search has taken furthest instead,
+* as GNU diff and git do.  The budget is checked once per edit distance,
+* so bisect() overruns it by at most one round of its searches.
+*
+* Build Process:
+* --------------
+* Required Files:
+*   TokDiff.h, TokDiff.cpp, LineIndex.h, LineIndex.cpp,
+*   Tokenizer.h, Tokenizer.cpp
+*
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.2 : 19 Oct 2026
+* - tokenize() catches what the Toker throws and reports it as false
+* ver 1.1 : 19 Oct 2026
+* - bisect() splits at the furthest point reached once it has searched
+*   too many edits, and gives up when compare()'s budget is spent
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <unordered_map>
+#include <algorithm>
+#include <exception>
+#include "TokDiff.h"
+#include "../Tokenizer/Tokenizer.h"
+
+using namespace Scanner;
+
+namespace
+{
+  const size_t CostPerToken = 1024;        // search steps allowed per token compared
+  const size_t MinCost = size_t(1) << 20;
+  const ptrdiff_t MinDistance = 256;      // edit distance bisect() searches exactly
+
+  //--reads a string in place
+  class TextBuf : public std::streambuf
+  {
+  public:
+    TextBuf(const std::string& text)
+    {
+      char* p = const_cast<char*>(text.data());
+      setg(p, p, p + text.size());
+    }
+  };
+
+  bool readFile(const std::string& path, std::string& text)
+  {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.good())
+      return false;
+    std::ostringstream out;
+    out << in.rdbuf();
+    text = out.str();
+    return true;
+  }
+}
+
+TokDiff::TokDiff(bool ignoreComments) : _ignoreComments(ignoreComments), _budget(0), _exact(true) {}
+
+bool TokDiff::diffFiles(const std::string& oldPath, const std::string& newPath)
+{
+  std::string oldText, newText;
+  if (!readFile(oldPath, oldText) || !readFile(newPath, newText))
+    return false;
+  return diffTexts(oldText, newText);
+}
+
+bool TokDiff::diffTexts(const std::string& oldText, const std::string& newText)
+{
+  _old.text = oldText;
+  _new.text = newText;
+  _hunks.clear();
+  _exact = true;
+  if (!tokenize(_old) || !tokenize(_new))
+  {
+    _old.toks.clear();
+    _new.toks.clear();
+    return false;
+  }
+
+  //--the common prefix and suffix are found on the strings, so only the
+  //  tokens between them are interned
+  size_t prefix = 0, suffix = 0;
+  size_t common = std::min(_old.toks.size(), _new.toks.size());
+  while (prefix < common && _old.toks[prefix] == _new.toks[prefix])
+    ++prefix;
+  while (suffix < common - prefix && _old.toks[_old.toks.size() - 1 - suffix] == _new.toks[_new.toks.size() - 1 - suffix])
+    ++suffix;
+
+  std::unordered_map<std::string, uint32_t> ids;
+  for (Version* pVersion : { &_old, &_new })
+  {
+    pVersion->ids.assign(pVersion->toks.size(), 0);
+    for (size_t i = prefix; i < pVersion->toks.size() - suffix; ++i)
+      pVersion->ids[i] = ids.emplace(pVersion->toks[i], static_cast<uint32_t>(ids.size())).first->second;
+  }
+  compare(prefix, suffix);
+  return true;
+}
+
+//--tokens and their offsets, without newlines; false if the Toker
+//  throws, on a byte order mark or another byte it can't classify
+bool TokDiff::tokenize(Version& version)
+{
+  version.toks.clear();
+  version.offsets.clear();
+  version.lines.assign(version.text.data(), version.text.size());
+  TextBuf buf(version.text);
+  std::istream in(&buf);
+  Toker toker;
+  toker.setCollectComments(!_ignoreComments);
+  if (!toker.attach(&in))
+    return true;   // nothing to read is an empty version
+  try
+  {
+    for (std::string tok = toker.getTok(); tok != ""; tok = toker.getTok())
+    {
+      if (tok == "\n")
+        continue;
+      version.offsets.push_back(toker.tokOffset());
+      version.toks.push_back(std::move(tok));
+    }
+  }
+  catch (std::exception&)
+  {
+    return false;
+  }
+  return true;
+}
+
+//--marks every token outside the common subsequence, then collects hunks
+void TokDiff::compare(size_t prefix, size_t suffix)
+{
+  const std::vector<uint32_t>& a = _old.ids;
+  const std::vector<uint32_t>& b = _new.ids;
+  _old.changed.assign(a.size(), 0);
+  _new.changed.assign(b.size(), 0);
+  size_t width = (a.size() + b.size() - 2 * (prefix + suffix) + 1) / 2 * 2 + 2;
+  _forward.resize(width);
+  _backward.resize(width);
+
+  _budget = MinCost + CostPerToken * (width - 2);
+  _exact = true;
+
+  struct Range { size_t aLo, aHi, bLo, bHi; };
+  std::vector<Range> work{ Range{ prefix, a.size() - suffix, prefix, b.size() - suffix } };
+  while (!work.empty())
+  {
+    Range r = work.back();
+    work.pop_back();
+    while (r.aLo < r.aHi && r.bLo < r.bHi && a[r.aLo] == b[r.bLo])
+      ++r.aLo, ++r.bLo;
+    while (r.aLo < r.aHi && r.bLo < r.bHi && a[r.aHi - 1] == b[r.bHi - 1])
+      --r.aHi, --r.bHi;
+    size_t x, y;
+    if (r.aLo == r.aHi || r.bLo == r.bHi || !bisect(r.aLo, r.aHi, r.bLo, r.bHi, x, y))
+    {
+      std::fill(_old.changed.begin() + r.aLo, _old.changed.begin() + r.aHi, 1);
+      std::fill(_new.changed.begin() + r.bLo, _new.changed.begin() + r.bHi, 1);
+      continue;
+    }
+    work.push_back(Range{ r.aLo, x, r.bLo, y });
+    work.push_back(Range{ x, r.aHi, y, r.bHi });
+  }
+
+  _hunks.clear();
+  size_t i = 0, j = 0;
+  while (i < a.size() || j < b.size())
+  {
+    if (i < a.size() && j < b.size() && !_old.changed[i] && !_new.changed[j])
+    {
+      ++i, ++j;
+      continue;
+    }
+    DiffHunk hunk{ i, 0, j, 0 };
+    while (i < a.size() && _old.changed[i])
+      ++i, ++hunk.oldCount;
+    while (j < b.size() && _new.changed[j])
+      ++j, ++hunk.newCount;
+    _hunks.push_back(hunk);
+  }
+}
+
+//--a point on a shortest edit path through a[aLo,aHi) and b[bLo,bHi);
+//  both ranges are non-empty and differ at both ends.  Each diagonal
+//  visited and each matching token followed costs one step of _budget;
+//  false, with the budget spent, if it runs out first
+bool TokDiff::bisect(size_t aLo, size_t aHi, size_t bLo, size_t bHi, size_t& xSplit, size_t& ySplit)
+{
+  const uint32_t* a = _old.ids.data() + aLo;
+  const uint32_t* b = _new.ids.data() + bLo;
+  const ptrdiff_t n = static_cast<ptrdiff_t>(aHi - aLo);
+  const ptrdiff_t m = static_cast<ptrdiff_t>(bHi - bLo);
+  const ptrdiff_t maxD = (n + m + 1) / 2;
+  const ptrdiff_t offset = maxD;
+  const ptrdiff_t length = 2 * maxD + 2;
+  std::fill(_forward.begin(), _forward.begin() + length, -1);
+  std::fill(_backward.begin(), _backward.begin() + length, -1);
+  _forward[offset + 1] = 0;
+  _backward[offset + 1] = 0;
+  const ptrdiff_t delta = n - m;
+  const bool front = (delta % 2) != 0;   // odd: paths meet during a forward step
+  ptrdiff_t k1start = 0, k1end = 0, k2start = 0, k2end = 0;
+  size_t spent = 0;
+  ptrdiff_t maxDistance = MinDistance;
+  while (maxDistance * maxDistance < n + m)
+    maxDistance *= 2;
+  for (ptrdiff_t d = 0; d < maxD; ++d)
+  {
+    if (spent > _budget)
+    {
+      _budget = 0;
+      _exact = false;
+      return false;
+    }
+    if (d == maxDistance)
+    {
+      _budget -= std::min(spent, _budget);
+      _exact = false;
+      return furthest(aLo, bLo, n, m, d, xSplit, ySplit);
+    }
+    spent += 4 * d + 2;   // the diagonals of both searches
+    for (ptrdiff_t k1 = -d + k1start; k1 <= d - k1end; k1 += 2)
+    {
+      ptrdiff_t k1Offset = offset + k1;
+      ptrdiff_t x1 = (k1 == -d || (k1 != d && _forward[k1Offset - 1] < _forward[k1Offset + 1]))
+        ? _forward[k1Offset + 1] : _forward[k1Offset - 1] + 1;
+      ptrdiff_t y1 = x1 - k1;
+      ptrdiff_t from = x1;
+      while (x1 < n && y1 < m && a[x1] == b[y1])
+        ++x1, ++y1;
+      spent += x1 - from;
+      _forward[k1Offset] = x1;
+      if (x1 > n)
+        k1end += 2;        // ran off the right edge
+      else if (y1 > m)
+        k1start += 2;      // ran off the bottom
+      else if (front)
+      {
+        ptrdiff_t k2Offset = offset + delta - k1;
+        if (k2Offset >= 0 && k2Offset < length && _backward[k2Offset] != -1 && x1 >= n - _backward[k2Offset])
+        {
+          xSplit = aLo + x1;
+          ySplit = bLo + y1;
+          _budget -= std::min(spent, _budget);
+          return true;
+        }
+      }
+    }
+    for (ptrdiff_t k2 = -d + k2start; k2 <= d - k2end; k2 += 2)
+    {
+      ptrdiff_t k2Offset = offset + k2;
+      ptrdiff_t x2 = (k2 == -d || (k2 != d && _backward[k2Offset - 1] < _backward[k2Offset + 1]))
+        ? _backward[k2Offset + 1] : _backward[k2Offset - 1] + 1;
+      ptrdiff_t y2 = x2 - k2;
+      ptrdiff_t from = x2;
+      while (x2 < n && y2 < m && a[n - x2 - 1] == b[m - y2 - 1])
+        ++x2, ++y2;
+      spent += x2 - from;
+      _backward[k2Offset] = x2;
+      if (x2 > n)
+        k2end += 2;
+      else if (y2 > m)
+        k2start += 2;
+      else if (!front)
+      {
+        ptrdiff_t k1Offset = offset + delta - k2;
+        if (k1Offset >= 0 && k1Offset < length && _forward[k1Offset] != -1)
+        {
+          ptrdiff_t x1 = _forward[k1Offset];
+          ptrdiff_t y1 = x1 - (k1Offset - offset);
+          if (x1 >= n - x2)
+          {
+            xSplit = aLo + x1;
+            ySplit = bLo + y1;
+            _budget -= std::min(spent, _budget);
+            return true;
+          }
+        }
+      }
+    }
+  }
+  // no common token at all: all of a is removed, then all of b inserted
+  _budget -= std::min(spent, _budget);
+  xSplit = aHi;
+  ySplit = bLo;
+  return true;
+}
+
+//--when bisect() has searched d edits without the searches meeting, the
+//  point either one has taken furthest from its corner; false if that
+//  point is a corner, which would leave the subproblem unchanged
+bool TokDiff::furthest(size_t aLo, size_t bLo, ptrdiff_t n, ptrdiff_t m, ptrdiff_t d, size_t& xSplit, size_t& ySplit)
+{
+  const ptrdiff_t offset = (n + m + 1) / 2;
+  ptrdiff_t bestX = 0, bestY = 0, best = 0;
+  for (ptrdiff_t k = -d; k <= d; ++k)
+  {
+    ptrdiff_t x = _forward[offset + k], y = x - k;
+    if (x >= 0 && x <= n && y >= 0 && y <= m && x + y > best)
+      bestX = x, bestY = y, best = x + y;
+    x = _backward[offset + k], y = x - k;
+    if (x >= 0 && x <= n && y >= 0 && y <= m && x + y > best)
+      bestX = n - x, bestY = m - y, best = x + y;
+  }
+  if (best == 0 || best == n + m)
+    return false;
+  xSplit = aLo + bestX;
+  ySplit = bLo + bestY;
+  return true;
+}
+
+size_t TokDiff::changedTokens() const
+{
+  size_t count = 0;
+  for (auto& hunk : _hunks)
+    count += hunk.oldCount + hunk.newCount;
+  return count;
+}
+
+//--each hunk as its old and new positions, removed and inserted tokens
+void TokDiff::show(std::ostream& out) const
+{
+  auto where = [](const Version& version, size_t i) {
+    if (i >= version.offsets.size())
+      return std::string("end");
+    TextPos pos = version.lines.position(version.offsets[i]);
+    return std::to_string(pos.line) + ":" + std::to_string(pos.column);
+  };
+  for (auto& hunk : _hunks)
+  {
+    out << "\n  @@ old " << where(_old, hunk.oldStart) << ", new " << where(_new, hunk.newStart) << " @@";
+    if (hunk.oldCount > 0)
+    {
+      out << "\n  -";
+      for (size_t i = hunk.oldStart; i < hunk.oldStart + hunk.oldCount; ++i)
+        out << " " << _old.toks[i];
+    }
+    if (hunk.newCount > 0)
+    {
+      out << "\n  +";
+      for (size_t i = hunk.newStart; i < hunk.newStart + hunk.newCount; ++i)
+        out << " " << _new.toks[i];
+    }
+  }
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_TOKDIFF
+
+#include <chrono>
+#include <random>
+
+int main()
+{
+  std::cout << "\n  <-----------Token Diff------------> \n";
+  std::string before =
+    "int add(int a, int b) { return a + b; }\n"
+    "// old comment\n"
+    "int twice(int x) { return add(x, x); }\n";
+  std::string after =
+    "int add(int a,\n"
+    "        int b)\n"
+    "{\n"
+    "  return a + b;     // reformatted only\n"
+    "}\n"
+    "int twice(long x) { return add(x, x) * 1; }\n";
+
+  TokDiff diff;
+  diff.diffTexts(before, after);
+  std::cout << "\n  reformatted, comments ignored: " << diff.hunks().size() << " hunks";
+  diff.show(std::cout);
+
+  TokDiff withComments(false);
+  withComments.diffTexts(before, after);
+  std::cout << "\n\n  comments compared: " << withComments.hunks().size() << " hunks";
+  withComments.show(std::cout);
+
+  //--a version the Toker throws on can't be compared
+  std::cout << "\n\n  ../Tokenizer/BomTestFile.txt against itself: "
+            << (diff.diffFiles("../Tokenizer/BomTestFile.txt", "../Tokenizer/BomTestFile.txt") ? "compared" : "unreadable")
+            << ", " << diff.hunks().size() << " hunks";
+
+  //--a large file with a few scattered edits
+  std::ifstream in("../Tokenizer/Tokenizer.cpp", std::ios::binary);
+  std::ostringstream source;
+  source << in.rdbuf();
+  std::string big;
+  while (big.size() < 2000000)
+    big += source.str();
+  std::string edited = big;
+  for (size_t at : { big.size() / 5, big.size() / 2, big.size() * 4 / 5 })
+    edited.insert(edited.find('\n', at) + 1, "int inserted = 1;\n");
+
+  auto start = std::chrono::steady_clock::now();
+  TokDiff large;
+  large.diffTexts(big, edited);
+  auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+  std::cout << "\n\n  " << large.oldTokens() << " tokens vs " << large.newTokens() << ": "
+            << large.hunks().size() << " hunks, " << large.changedTokens() << " tokens changed, "
+            << ms << " ms including tokenizing";
+
+  //--100k tokens with 10% and 50% of them replaced: the caps keep these
+  //  from taking O(ND), and the hunks still rebuild the new version
+  std::mt19937 random(1);
+  std::string words;
+  for (size_t i = 0; i < 100000; ++i)
+    words += "w" + std::to_string(random() % 1000) + " ";
+  for (unsigned percent : { 10, 50 })
+  {
+    std::string changed;
+    std::istringstream wordsIn(words);
+    for (std::string word; wordsIn >> word; )
+      changed += (random() % 100 < percent ? "v" + std::to_string(random() % 1000) : word) + " ";
+    start = std::chrono::steady_clock::now();
+    TokDiff rewritten;
+    rewritten.diffTexts(words, changed);
+    ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    std::vector<std::string> rebuilt;
+    size_t at = 0;
+    for (auto& hunk : rewritten.hunks())
+    {
+      for (; at < hunk.oldStart; ++at)
+        rebuilt.push_back(rewritten.oldToken(at));
+      for (size_t i = hunk.newStart; i < hunk.newStart + hunk.newCount; ++i)
+        rebuilt.push_back(rewritten.newToken(i));
+      at += hunk.oldCount;
+    }
+    for (; at < rewritten.oldTokens(); ++at)
+      rebuilt.push_back(rewritten.oldToken(at));
+    bool same = rebuilt.size() == rewritten.newTokens();
+    for (size_t i = 0; same && i < rebuilt.size(); ++i)
+      same = rebuilt[i] == rewritten.newToken(i);
+    std::cout << "\n  " << percent << "% of " << rewritten.oldTokens() << " tokens replaced: "
+              << rewritten.changedTokens() << " tokens changed, " << (rewritten.exact() ? "minimal" : "not minimal")
+              << ", hunks " << (same ? "rebuild" : "DON'T rebuild") << " the new version, " << ms << " ms";
+  }
+  std::cout << "\n\n";
+  return 0;
+}
+#endif
@@ -0,0 +1,129 @@
+#ifndef TOKDIFF_H
+#define TOKDIFF_H
+///////////////////////////////////////////////////////////////////////
+// TokDiff.h - token-level diff of two versions of a file            //
+// ver 1.2                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* A line diff of a reformatted file reports every reflowed line.  TokDiff
+* compares the Toker's tokens instead, so changes in whitespace, line
+* breaks and, optionally, comments do not show at all.  Newline tokens
+* are always dropped; comments are dropped unless the TokDiff was made
+* with ignoreComments false, in which case they are collected and
+* compared like any other token.
+*
+* Each distinct token text is interned to an integer id and the id arrays
+* are compared with Myers' O(ND) algorithm in its linear-space form, so
+* time grows with the size of the difference, not of the files.  The
+* common prefix and suffix of every subproblem are skipped before any
+* search, which for a small edit to a large file is nearly all the work.
+*
+* Myers' algorithm costs O((N+M)D) for a difference of D tokens, which is
+* quadratic when the versions are largely unrelated: 100k tokens with
+* half of them replaced take about 40 s.  Two caps bound it.  A search
+* that has gone about sqrt(N+M) edits, at least 256, without finding the
+* middle of its subproblem splits it at the furthest point it reached,
+* which is usually close to minimal.  And compare() as a whole has a
+* budget of 1024 search steps per token plus about a million, after
+* which every subproblem not yet solved becomes one hunk replacing its
+* old tokens with its new ones.  The same 100k tokens then take about
+* 0.4 s.  The hunks always turn the old version into the new one, and
+* exact() tells whether they are also minimal.
+*
+* The result is a list of hunks, each a run of removed tokens of the old
+* version and the run of tokens that replaced it, either of which may be
+* empty.  show() prints them with line:column positions.
+*
+* A version holding bytes the Toker rejects, such as a UTF-8 byte order
+* mark, can't be compared: diffTexts() and diffFiles() return false and
+* leave no hunks.
+*
+* Public Interface:
+* -----------------
+* TokDiff diff;                     // TokDiff diff(false) to compare comments
+* diff.diffFiles("old/Tokenizer.cpp", "Tokenizer.cpp");
+* for (auto& hunk : diff.hunks()) { ... }
+* diff.show(std::cout);
+*
+* Build Process:
+* --------------
+* Required Files:
+*   TokDiff.h, TokDiff.cpp, LineIndex.h, LineIndex.cpp,
+*   Tokenizer.h, Tokenizer.cpp
+*
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.2 : 19 Oct 2026
+* - diffTexts() returns false, and diffFiles() too, when the Toker throws
+*   on either version, instead of letting the exception escape
+* ver 1.1 : 19 Oct 2026
+* - compare() has a search budget, beyond which the remaining differences
+*   are coarse replace hunks, and exact() says whether that happened
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <iosfwd>
+#include "../LineIndex/LineIndex.h"
+
+namespace Scanner
+{
+  struct DiffHunk
+  {
+    size_t oldStart;    // token index in the old version
+    size_t oldCount;
+    size_t newStart;    // token index in the new version
+    size_t newCount;
+  };
+
+  class TokDiff
+  {
+  public:
+    explicit TokDiff(bool ignoreComments = true);
+    bool diffFiles(const std::string& oldPath, const std::string& newPath);   //false if either can't be read
+    bool diffTexts(const std::string& oldText, const std::string& newText);   //false if either can't be tokenized
+    const std::vector<DiffHunk>& hunks() const { return _hunks; }
+    size_t changedTokens() const;   //removed plus inserted
+    bool exact() const { return _exact; }   //false if the budget ran out
+    const std::string& oldToken(size_t i) const { return _old.toks[i]; }
+    const std::string& newToken(size_t i) const { return _new.toks[i]; }
+    size_t oldTokens() const { return _old.toks.size(); }
+    size_t newTokens() const { return _new.toks.size(); }
+    void show(std::ostream& out) const;
+  private:
+    struct Version
+    {
+      std::string text;
+      std::vector<std::string> toks;
+      std::vector<size_t> offsets;
+      std::vector<uint32_t> ids;
+      std::vector<char> changed;
+      LineIndex lines;
+    };
+    bool tokenize(Version& version);
+    void compare(size_t prefix, size_t suffix);
+    bool bisect(size_t aLo, size_t aHi, size_t bLo, size_t bHi, size_t& xSplit, size_t& ySplit);
+    bool furthest(size_t aLo, size_t bLo, ptrdiff_t n, ptrdiff_t m, ptrdiff_t d, size_t& xSplit, size_t& ySplit);
+    bool _ignoreComments;
+    Version _old;
+    Version _new;
+    std::vector<ptrdiff_t> _forward;
+    std::vector<ptrdiff_t> _backward;
+    std::vector<DiffHunk> _hunks;
+    size_t _budget;   // search steps left to compare()
+    bool _exact;
+  };
+}
+#endif
@@ -0,0 +1,461 @@
+///////////////////////////////////////////////////////////////////////
+// TokStats.cpp - corpus token statistics in bounded memory          //
+// ver 1.1                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* Each identifier is hashed once to 64 bits; the count-min rows use
+* h1 + i * h2 from its two halves, HyperLogLog its top bits.  The sketch
+* uses conservative update, raising only the cells that hold the current
+* minimum, which keeps estimates an upper bound but makes them tighter.
+* Every cell still holds at least the count of each identifier hashed to
+* it and at most what plain updates would give, so merge() adding cells
+* keeps both the upper bound and the error bound.
+*
+* The top-k list is a plain vector with the position of its smallest
+* count remembered.  An identifier whose new estimate does not beat that
+* smallest count cannot be in the list, since its listed count would be
+* below its new estimate, so most identifiers are turned away without
+* searching it.
+*
+* Build Process:
+* --------------
+* Required Files:
+*   TokStats.h, TokStats.cpp, ScannerPool.h, ScannerPool.cpp, SemiExp.h,
+*   SemiExp.cpp, SemiRules.h, SemiRules.cpp, Tokenizer.h, Tokenizer.cpp
+*
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 19 Oct 2026
+* - addStream() catches Toker exceptions; collectStats() lists the file
+*   as unreadable
+* - addStream() joins identifiers the Toker split at '_'
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <atomic>
+#include <cmath>
+#include <cctype>
+#include "TokStats.h"
+#include "../ScannerPool/ScannerPool.h"
+
+using namespace Scanner;
+
+namespace
+{
+  bool isWordChar(char ch)
+  {
+    return std::isalnum(static_cast<unsigned char>(ch)) || ch == '_';
+  }
+
+  //--newlines, comments and quoted text are counted as the Toker gives them
+  bool isWhole(const std::string& tok)
+  {
+    return tok == "\n" || tok[0] == '"' || tok[0] == '\'' || tok.compare(0, 2, "//") == 0 || tok.compare(0, 2, "/*") == 0;
+  }
+
+  //--FNV-1a, then a final mix so every output bit depends on every input bit
+  uint64_t hashOf(const std::string& key)
+  {
+    uint64_t h = 14695981039346656037ull;
+    for (unsigned char ch : key)
+      h = (h ^ ch) * 1099511628211ull;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    return h ^ (h >> 33);
+  }
+
+  size_t leadingZeros(uint64_t value)
+  {
+    size_t n = 0;
+    for (uint64_t bit = uint64_t(1) << 63; bit != 0 && (value & bit) == 0; bit >>= 1)
+      ++n;
+    return n;
+  }
+}
+
+//----< CountMinSketch >---------------------------------------------
+
+CountMinSketch::CountMinSketch(size_t width, size_t depth)
+  : _width(std::max<size_t>(width, 1)), _depth(std::max<size_t>(depth, 1)), _total(0),
+    _cells(_width * _depth, 0) {}
+
+uint64_t CountMinSketch::add(uint64_t hash, uint64_t count)
+{
+  uint64_t h1 = hash & 0xffffffff, h2 = (hash >> 32) | 1;
+  uint64_t target = estimate(hash) + count;
+  for (size_t row = 0; row < _depth; ++row)
+  {
+    uint32_t& cell = _cells[row * _width + (h1 + row * h2) % _width];
+    if (cell < target)
+      cell = static_cast<uint32_t>(std::min<uint64_t>(target, UINT32_MAX));
+  }
+  _total += count;
+  return std::min<uint64_t>(target, UINT32_MAX);
+}
+
+uint64_t CountMinSketch::estimate(uint64_t hash) const
+{
+  uint64_t h1 = hash & 0xffffffff, h2 = (hash >> 32) | 1;
+  uint32_t least = UINT32_MAX;
+  for (size_t row = 0; row < _depth; ++row)
+    least = std::min(least, _cells[row * _width + (h1 + row * h2) % _width]);
+  return least;
+}
+
+void CountMinSketch::merge(const CountMinSketch& other)
+{
+  if (other._width != _width || other._depth != _depth)
+    throw(std::invalid_argument("CountMinSketch: merging sketches of different shape"));
+  for (size_t i = 0; i < _cells.size(); ++i)
+    _cells[i] = static_cast<uint32_t>(std::min<uint64_t>(uint64_t(_cells[i]) + other._cells[i], UINT32_MAX));
+  _total += other._total;
+}
+
+//----< HyperLogLog >------------------------------------------------
+
+HyperLogLog::HyperLogLog(size_t precision)
+  : _precision(std::min<size_t>(std::max<size_t>(precision, 4), 18)), _registers(size_t(1) << _precision, 0) {}
+
+void HyperLogLog::add(uint64_t hash)
+{
+  size_t index = static_cast<size_t>(hash >> (64 - _precision));
+  uint64_t rest = (hash << _precision) | (uint64_t(1) << (_precision - 1));   // caps the rank
+  uint8_t rank = static_cast<uint8_t>(leadingZeros(rest) + 1);
+  if (rank > _registers[index])
+    _registers[index] = rank;
+}
+
+double HyperLogLog::estimate() const
+{
+  double m = static_cast<double>(_registers.size());
+  double sum = 0;
+  size_t zeros = 0;
+  for (uint8_t reg : _registers)
+  {
+    sum += std::ldexp(1.0, -reg);
+    if (reg == 0)
+      ++zeros;
+  }
+  double alpha = 0.7213 / (1 + 1.079 / m);
+  double raw = alpha * m * m / sum;
+  if (raw <= 2.5 * m && zeros > 0)
+    return m * std::log(m / zeros);   // linear counting for small sets
+  return raw;
+}
+
+void HyperLogLog::merge(const HyperLogLog& other)
+{
+  if (other._precision != _precision)
+    throw(std::invalid_argument("HyperLogLog: merging sketches of different precision"));
+  for (size_t i = 0; i < _registers.size(); ++i)
+    _registers[i] = std::max(_registers[i], other._registers[i]);
+}
+
+//----< TokStats >---------------------------------------------------
+
+TokStats::TokStats(const StatsShape& shape)
+  : _shape(shape), _identifiers(shape.sketchWidth, shape.sketchDepth), _distinct(shape.hllPrecision),
+    _minTop(0), _otherPunctuators(0), _tokens(0) {}
+
+//--keeps key in the top-k list if its count earns a place
+void TokStats::offer(const std::string& key, uint64_t count)
+{
+  if (_top.size() == _shape.topK && (_shape.topK == 0 || count <= _top[_minTop].count))
+    return;
+  size_t i = 0;
+  while (i < _top.size() && _top[i].key != key)
+    ++i;
+  if (i == _top.size())
+  {
+    if (_top.size() < _shape.topK)
+      _top.push_back(HeavyHitter{ key, count });
+    else
+      _top[_minTop] = HeavyHitter{ key, count };
+  }
+  else
+    _top[i].count = count;
+  _minTop = 0;
+  for (size_t j = 1; j < _top.size(); ++j)
+    if (_top[j].count < _top[_minTop].count)
+      _minTop = j;
+}
+
+void TokStats::addToken(const std::string& tok)
+{
+  if (tok == "\n" || tok.empty())
+    return;
+  ++_tokens;
+  unsigned char first = tok[0];
+  if (std::isalpha(first) || first == '_')
+  {
+    uint64_t hash = hashOf(tok);
+    _distinct.add(hash);
+    offer(tok, _identifiers.add(hash));
+  }
+  else if (std::ispunct(first) && first != '"' && first != '\'' && tok.compare(0, 2, "//") != 0 && tok.compare(0, 2, "/*") != 0)
+  {
+    auto found = _punctuators.find(tok);
+    if (found != _punctuators.end())
+      ++found->second;
+    else if (_punctuators.size() < _shape.maxPunctuators)
+      _punctuators[tok] = 1;
+    else
+      ++_otherPunctuators;
+  }
+}
+
+//--the Toker returns '_' as a punctuator, so size_t arrives as size, _
+//  and t; word pieces that touch are joined again before counting
+bool TokStats::addStream(std::istream& in)
+{
+  ScannerPool::Lease scanner = ScannerPool::local().acquire(&in);
+  if (!scanner.attached())
+    return true;
+  Toker& toker = scanner.toker();
+  std::string word;      // touching word pieces read so far
+  size_t wordEnd = 0;    // offset just past them
+  auto flush = [&]() {
+    if (!word.empty())
+      addToken(word);
+    word.clear();
+  };
+  bool good = true;
+  try
+  {
+    for (std::string tok = toker.getTok(); tok != ""; tok = toker.getTok())
+    {
+      size_t offset = toker.tokOffset();
+      if (isWhole(tok) || (!isWordChar(tok[0]) && tok.find('_') == std::string::npos))
+      {
+        flush();
+        addToken(tok);
+        continue;
+      }
+      for (size_t i = 0, j = 0; i < tok.size(); i = j)
+      {
+        bool inWord = isWordChar(tok[i]);
+        while (j < tok.size() && isWordChar(tok[j]) == inWord)
+          ++j;
+        if (!inWord)
+        {
+          flush();
+          addToken(tok.substr(i, j - i));
+          continue;
+        }
+        if (wordEnd != offset + i)
+          flush();
+        word.append(tok, i, j - i);
+        wordEnd = offset + j;
+      }
+    }
+  }
+  catch (std::exception&)   // bytes the Toker can't classify, such as a BOM
+  {
+    good = false;
+  }
+  flush();
+  return good;
+}
+
+void TokStats::merge(const TokStats& other)
+{
+  if (other._shape.topK != _shape.topK || other._shape.maxPunctuators != _shape.maxPunctuators)
+    throw(std::invalid_argument("TokStats: merging statistics of different shape"));
+  _identifiers.merge(other._identifiers);
+  _distinct.merge(other._distinct);
+  for (auto& entry : other._punctuators)
+  {
+    auto found = _punctuators.find(entry.first);
+    if (found != _punctuators.end())
+      found->second += entry.second;
+    else if (_punctuators.size() < _shape.maxPunctuators)
+      _punctuators.insert(entry);
+    else
+      _otherPunctuators += entry.second;
+  }
+  _otherPunctuators += other._otherPunctuators;
+  _tokens += other._tokens;
+
+  //--both lists' identifiers, re-estimated from the merged sketch
+  std::vector<HeavyHitter> candidates = _top;
+  candidates.insert(candidates.end(), other._top.begin(), other._top.end());
+  _top.clear();
+  _minTop = 0;
+  for (auto& hit : candidates)
+    offer(hit.key, _identifiers.estimate(hashOf(hit.key)));
+}
+
+std::vector<HeavyHitter> TokStats::top() const
+{
+  std::vector<HeavyHitter> result = _top;
+  std::sort(result.begin(), result.end(), [](const HeavyHitter& a, const HeavyHitter& b) {
+    return a.count != b.count ? a.count > b.count : a.key < b.key;
+  });
+  return result;
+}
+
+uint64_t TokStats::estimate(const std::string& identifier) const
+{
+  return _identifiers.estimate(hashOf(identifier));
+}
+
+size_t TokStats::distinctIdentifiers() const
+{
+  return static_cast<size_t>(std::llround(_distinct.estimate()));
+}
+
+uint64_t TokStats::errorBound() const
+{
+  return static_cast<uint64_t>(std::ceil(std::exp(1.0) / _identifiers.width() * _identifiers.total()));
+}
+
+void TokStats::show(std::ostream& out, size_t rows) const
+{
+  out << "\n  " << _tokens << " tokens, " << identifiers() << " identifiers, about "
+      << distinctIdentifiers() << " distinct; counts high by at most " << errorBound();
+  out << "\n  most frequent identifiers:";
+  std::vector<HeavyHitter> hits = top();
+  for (size_t i = 0; i < hits.size() && i < rows; ++i)
+    out << "\n    " << std::left << std::setw(16) << hits[i].key << std::right << hits[i].count;
+  std::vector<std::pair<std::string, uint64_t>> puncts(_punctuators.begin(), _punctuators.end());
+  std::sort(puncts.begin(), puncts.end(), [](const std::pair<std::string, uint64_t>& a, const std::pair<std::string, uint64_t>& b) {
+    return a.second != b.second ? a.second > b.second : a.first < b.first;
+  });
+  out << "\n  most frequent punctuators:";
+  for (size_t i = 0; i < puncts.size() && i < rows; ++i)
+    out << "\n    " << std::left << std::setw(16) << puncts[i].first << std::right << puncts[i].second;
+  if (_otherPunctuators > 0)
+    out << "\n    " << std::left << std::setw(16) << "(other)" << std::right << _otherPunctuators;
+}
+
+//--one TokStats per thread, merged once every thread has finished
+TokStats Scanner::collectStats(const std::vector<std::string>& files, size_t nThreads, const StatsShape& shape,
+  std::vector<size_t>* pUnreadable)
+{
+  if (nThreads == 0)
+    nThreads = std::max(1u, std::thread::hardware_concurrency());
+  nThreads = std::max(size_t(1), std::min(nThreads, files.size()));
+  std::vector<TokStats> partial(nThreads, TokStats(shape));
+  std::vector<std::vector<size_t>> unreadable(nThreads);
+  std::atomic<size_t> next(0);
+  auto worker = [&](size_t t) {
+    size_t i;
+    while ((i = next++) < files.size())
+    {
+      std::ifstream in(files[i]);
+      if (!in.good() || !partial[t].addStream(in))
+        unreadable[t].push_back(i);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t t = 1; t < nThreads; ++t)
+    threads.push_back(std::thread(worker, t));
+  worker(0);
+  for (auto& thrd : threads)
+    thrd.join();
+
+  TokStats total = partial[0];
+  for (size_t t = 1; t < nThreads; ++t)
+    total.merge(partial[t]);
+  if (pUnreadable != nullptr)
+  {
+    pUnreadable->clear();
+    for (auto& u : unreadable)
+      pUnreadable->insert(pUnreadable->end(), u.begin(), u.end());
+    std::sort(pUnreadable->begin(), pUnreadable->end());
+  }
+  return total;
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_TOKSTATS
+
+#include <unordered_map>
+
+int main()
+{
+  std::cout << "\n  <-----------Token Statistics------------> \n";
+  std::vector<std::string> files = {
+    "../Tokenizer/Tokenizer.cpp", "../Tokenizer/Tokenizer.h", "../SemiExp/SemiExp.cpp",
+    "../SemiExp/SemiExp.h", "../Analyzer/Analyzer.cpp", "../Indexer/Indexer.cpp",
+    "../TokenSearch/TokenSearch.cpp", "../Sink/Sink.cpp", "../TokDaemon/TokDaemon.cpp",
+    "../TokDiff/TokDiff.cpp", "../Trace/Trace.cpp", "../Bench/Bench.cpp",
+    "../Tokenizer/BomTestFile.txt"
+  };
+  StatsShape shape;
+  shape.sketchWidth = 1024;    // small, so the bounds are visible
+  std::vector<size_t> unreadable;
+  TokStats stats = collectStats(files, 4, shape, &unreadable);
+  stats.show(std::cout);
+  for (size_t file : unreadable)
+    std::cout << "\n  " << files[file] << ": unreadable";
+
+  //--exact counts, for comparison, joining word pieces the same way
+  std::unordered_map<std::string, uint64_t> exact;
+  for (auto& file : files)
+  {
+    std::ifstream in(file);
+    Toker toker;
+    toker.attach(&in);
+    std::string word;
+    size_t wordEnd = 0;
+    auto flush = [&]() {
+      if (!word.empty() && (std::isalpha(static_cast<unsigned char>(word[0])) || word[0] == '_'))
+        ++exact[word];
+      word.clear();
+    };
+    try
+    {
+      for (std::string tok = toker.getTok(); tok != ""; tok = toker.getTok())
+      {
+        bool whole = isWhole(tok) || (!isWordChar(tok[0]) && tok.find('_') == std::string::npos);
+        for (size_t i = 0; i < tok.size() && !whole; ++i)
+        {
+          if (!isWordChar(tok[i]) || wordEnd != toker.tokOffset() + i)
+            flush();
+          if (isWordChar(tok[i]))
+          {
+            word += tok[i];
+            wordEnd = toker.tokOffset() + i + 1;
+          }
+        }
+        if (whole)
+          flush();
+      }
+    }
+    catch (std::exception&) {}   // counted as far as collectStats() got
+    flush();
+  }
+  bool within = true;
+  for (auto& entry : exact)
+  {
+    uint64_t est = stats.estimate(entry.first);
+    within = within && est >= entry.second && est <= entry.second + stats.errorBound();
+  }
+  std::cout << "\n\n  exact distinct identifiers: " << exact.size();
+  std::cout << "\n  every estimate within [count, count + bound]: " << (within ? "yes" : "no");
+  std::cout << "\n  exact counts of the top three:";
+  std::vector<HeavyHitter> hits = stats.top();
+  for (size_t i = 0; i < 3 && i < hits.size(); ++i)
+    std::cout << " " << hits[i].key << " " << exact[hits[i].key];
+  std::cout << "\n\n";
+  return 0;
+}
+#endif
@@ -0,0 +1,158 @@
+#ifndef TOKSTATS_H
+#define TOKSTATS_H
+///////////////////////////////////////////////////////////////////////
+// TokStats.h - corpus token statistics in bounded memory            //
+// ver 1.1                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* Exact identifier counts need a map entry per distinct identifier, which
+* a large enough corpus will exhaust.  TokStats instead keeps sketches
+* whose size is fixed when it is constructed:
+*   CountMinSketch - approximate count of any identifier; never low, and
+*                    high by at most e/width of all identifiers counted,
+*                    with probability 1 - e^-depth
+*   top-k list     - the k identifiers with the highest estimated counts
+*                    seen so far, refreshed from the sketch as they recur
+*   HyperLogLog    - number of distinct identifiers, within about
+*                    1.04 / sqrt(2^precision)
+* Punctuators and other operator tokens are few, so they are counted
+* exactly, up to a fixed number of distinct ones; any beyond that are
+* counted together as "other".
+*
+* An identifier is a word of letters, digits and underscores that starts
+* with a letter or underscore, keywords included.  The Toker returns
+* '_' as a punctuator, splitting size_t into size, _ and t; addStream()
+* joins word pieces whose offsets touch before counting them, so
+* identifiers are counted whole and '_' is not counted as a punctuator.
+* Sketches of equal shape merge by adding counts.  The HyperLogLog and
+* the punctuator counts come out as if one TokStats had seen both
+* inputs.  CountMinSketch estimates stay upper bounds within the same
+* error bound, but conservative update makes them tighter in one sketch
+* than in a merge, and the merged top-k list can only hold identifiers
+* that made one of the two lists.  collectStats() gives each thread its
+* own TokStats and merges them after the threads join, so its estimates
+* and top-k list can differ slightly with the number of threads.
+*
+* A stream holding bytes the Toker rejects, such as a UTF-8 byte order
+* mark, is counted up to that point; addStream() then returns false and
+* collectStats() lists the file as unreadable.
+*
+* Public Interface:
+* -----------------
+* TokStats stats;                          // or TokStats(StatsShape{...})
+* stats.addStream(in);
+* stats.merge(otherThreadsStats);
+* for (auto& hit : stats.top()) std::cout << hit.key << " " << hit.count;
+* size_t distinct = stats.distinctIdentifiers();
+* std::vector<size_t> unreadable;
+* TokStats all = collectStats(files, 4, StatsShape(), &unreadable);
+*
+* Build Process:
+* --------------
+* Required Files:
+*   TokStats.h, TokStats.cpp, ScannerPool.h, ScannerPool.cpp, SemiExp.h,
+*   SemiExp.cpp, SemiRules.h, SemiRules.cpp, Tokenizer.h, Tokenizer.cpp
+*
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 19 Oct 2026
+* - collectStats() reports files the Toker throws on as unreadable
+*   instead of ending the process from a worker thread
+* - identifiers the Toker splits at '_' are counted whole
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+#include <iosfwd>
+
+namespace Scanner
+{
+  class CountMinSketch
+  {
+  public:
+    CountMinSketch(size_t width, size_t depth);
+    uint64_t add(uint64_t hash, uint64_t count = 1);   //returns the new estimate
+    uint64_t estimate(uint64_t hash) const;
+    void merge(const CountMinSketch& other);
+    uint64_t total() const { return _total; }
+    size_t width() const { return _width; }
+    size_t depth() const { return _depth; }
+  private:
+    size_t _width;
+    size_t _depth;
+    uint64_t _total;
+    std::vector<uint32_t> _cells;
+  };
+
+  class HyperLogLog
+  {
+  public:
+    explicit HyperLogLog(size_t precision);
+    void add(uint64_t hash);
+    double estimate() const;
+    void merge(const HyperLogLog& other);
+    size_t precision() const { return _precision; }
+  private:
+    size_t _precision;
+    std::vector<uint8_t> _registers;
+  };
+
+  struct StatsShape
+  {
+    size_t sketchWidth = 1 << 14;
+    size_t sketchDepth = 4;
+    size_t topK = 32;
+    size_t hllPrecision = 14;
+    size_t maxPunctuators = 256;
+  };
+
+  struct HeavyHitter
+  {
+    std::string key;
+    uint64_t count;   // estimate, never below the true count
+  };
+
+  class TokStats
+  {
+  public:
+    explicit TokStats(const StatsShape& shape = StatsShape());
+    void addToken(const std::string& tok);
+    bool addStream(std::istream& in);   //false if the Toker gave up on it
+    void merge(const TokStats& other);   //throws std::invalid_argument if shapes differ
+    std::vector<HeavyHitter> top() const;   //highest count first
+    uint64_t estimate(const std::string& identifier) const;
+    size_t distinctIdentifiers() const;
+    uint64_t identifiers() const { return _identifiers.total(); }
+    uint64_t tokens() const { return _tokens; }
+    uint64_t errorBound() const;   //most any estimate exceeds its count, usually
+    const std::map<std::string, uint64_t>& punctuators() const { return _punctuators; }
+    uint64_t otherPunctuators() const { return _otherPunctuators; }
+    void show(std::ostream& out, size_t rows = 10) const;
+  private:
+    void offer(const std::string& key, uint64_t count);
+    StatsShape _shape;
+    CountMinSketch _identifiers;
+    HyperLogLog _distinct;
+    std::vector<HeavyHitter> _top;
+    size_t _minTop;
+    std::map<std::string, uint64_t> _punctuators;
+    uint64_t _otherPunctuators;
+    uint64_t _tokens;
+  };
+
+  TokStats collectStats(const std::vector<std::string>& files, size_t nThreads = 0,
+    const StatsShape& shape = StatsShape(), std::vector<size_t>* pUnreadable = nullptr);
+}
+#endif
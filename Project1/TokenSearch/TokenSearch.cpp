@@ -0,0 +1,478 @@
+///////////////////////////////////////////////////////////////////////
+// TokenSearch.cpp - search token-sequence patterns across files     //
+// ver 1.4                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* Each pattern is split at "..." into segments, and each segment is split
+* at "?" into pieces, runs of concrete tokens.  Every piece of every
+* pattern becomes a keyword of a single Aho-Corasick automaton over
+* interned token ids, compiled into a dense transition table so matching
+* costs one table lookup per token.
+*
+* While a file is scanned, a Matcher reassembles pieces into segments
+* (all pieces of a segment found at the right offsets from a common start)
+* and segments into patterns (segments found in order, each starting after
+* the previous one ended).  Tokens that appear in no pattern map to id 0
+* and simply drive the automaton back towards its root.
+*
+* Build Process:
+* --------------
+* Required Files:
+*   TokenSearch.h, TokenSearch.cpp, Tokenizer.h, Tokenizer.cpp,
+*   LineIndex.h, LineIndex.cpp, ScannerPool.h, ScannerPool.cpp, SemiExp.h,
+*   SemiExp.cpp, SemiRules.h, SemiRules.cpp
+*
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.4 : 19 Oct 2026
+* - a token that completes several segments of one pattern advances it
+*   by the last of them, so "a ... a" matches "a x a"
+* ver 1.3 : 19 Oct 2026
+* - searchFiles() workers catch Toker exceptions and report the file
+*   as unreadable
+* ver 1.2 : 19 Oct 2026
+* - scans with Tokers leased from the thread's ScannerPool
+* ver 1.1 : 19 Oct 2026
+* - track token offsets instead of counting newline tokens
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <queue>
+#include <map>
+#include <thread>
+#include <atomic>
+#include <stdexcept>
+#include <cstdint>
+#include "TokenSearch.h"
+#include "../Tokenizer/Tokenizer.h"
+#include "../ScannerPool/ScannerPool.h"
+#include "../LineIndex/LineIndex.h"
+
+using namespace Scanner;
+
+//----< returns id of tok, adding it if not already interned >-------
+
+TokId TokenInterner::intern(const std::string& tok)
+{
+  auto iter = _ids.find(tok);
+  if (iter != _ids.end())
+    return iter->second;
+  TokId id = static_cast<TokId>(_ids.size() + 1);
+  _ids[tok] = id;
+  return id;
+}
+
+//----< returns id of tok or 0 if it was never interned >------------
+
+TokId TokenInterner::lookup(const std::string& tok) const
+{
+  auto iter = _ids.find(tok);
+  if (iter == _ids.end())
+    return 0;
+  return iter->second;
+}
+
+//----< matches pieces and segments for one file >-------------------
+
+class TokenSearch::Matcher
+{
+public:
+  Matcher(const TokenSearch& search, size_t file, std::vector<SearchMatch>& found);
+  void step(TokId id, size_t offset);
+private:
+  struct Progress
+  {
+    size_t nextSeg;
+    size_t minStart;
+    size_t matchOffset;
+  };
+  struct Completed
+  {
+    size_t pattern;
+    size_t segment;
+    size_t start;
+  };
+  void pieceFound(const Piece& piece);
+  bool segmentFound(size_t pattern, size_t segment, size_t start);
+  const TokenSearch& _search;
+  size_t _file;
+  std::vector<SearchMatch>& _found;
+  size_t _state;
+  size_t _pos;
+  size_t _mask;
+  std::vector<size_t> _offsets;      // offset of each recent token position
+  std::vector<Progress> _progress;   // one per pattern
+  std::vector<size_t> _segBase;      // first _pending slot of each pattern
+  std::vector<std::vector<std::pair<size_t, size_t>>> _pending;  // (start, next piece)
+  std::vector<Completed> _completed;   // segments ending at _pos
+};
+
+TokenSearch::Matcher::Matcher(const TokenSearch& search, size_t file, std::vector<SearchMatch>& found)
+  : _search(search), _file(file), _found(found), _state(0), _pos(0)
+{
+  size_t ring = 1;
+  while (ring < search._maxSegment)
+    ring <<= 1;
+  _mask = ring - 1;
+  _offsets.resize(ring);
+  _progress.resize(search._patterns.size(), Progress{ 0, 0, 0 });
+  size_t slots = 0;
+  for (auto& pat : search._patterns)
+  {
+    _segBase.push_back(slots);
+    slots += pat.segments.size();
+  }
+  _pending.resize(slots);
+}
+
+//--advances the automaton by one code token
+void TokenSearch::Matcher::step(TokId id, size_t offset)
+{
+  _offsets[_pos & _mask] = offset;
+  _state = _search._delta[_state * _search._alphabet + id];
+  for (size_t piece : _search._outputs[_state])
+    pieceFound(_search._pieces[piece]);
+  if (_completed.size() > 1)
+    std::stable_sort(_completed.begin(), _completed.end(), [](const Completed& x, const Completed& y) {
+      return x.pattern != y.pattern ? x.pattern < y.pattern : x.segment > y.segment;
+    });
+  size_t advanced = SIZE_MAX;
+  for (auto& c : _completed)
+    if (c.pattern != advanced && segmentFound(c.pattern, c.segment, c.start))
+      advanced = c.pattern;
+  _completed.clear();
+  ++_pos;
+}
+
+//--a piece ends at _pos; collect it into its segment
+void TokenSearch::Matcher::pieceFound(const Piece& piece)
+{
+  if (_pos + 1 < piece.length + piece.offset)
+    return;
+  size_t start = _pos + 1 - piece.length - piece.offset;
+  const Segment& seg = _search._patterns[piece.pattern].segments[piece.segment];
+  if (seg.pieces == 1)
+  {
+    _completed.push_back(Completed{ piece.pattern, piece.segment, start });
+    return;
+  }
+  auto& pending = _pending[_segBase[piece.pattern] + piece.segment];
+  pending.erase(std::remove_if(pending.begin(), pending.end(),
+    [&](const std::pair<size_t, size_t>& p) { return p.first + seg.length <= _pos; }), pending.end());
+  if (piece.index == 0)
+  {
+    pending.push_back(std::make_pair(start, size_t(1)));
+    return;
+  }
+  for (size_t i = 0; i < pending.size(); ++i)
+  {
+    if (pending[i].first != start || pending[i].second != piece.index)
+      continue;
+    if (++pending[i].second == seg.pieces)
+    {
+      pending.erase(pending.begin() + i);
+      _completed.push_back(Completed{ piece.pattern, piece.segment, start });
+    }
+    return;
+  }
+}
+
+//--a whole segment starts at start; advance the pattern's progress,
+//  returning whether it did.  step() offers a pattern's segments ending
+//  at one token last first and stops at the first taken, so the closing
+//  a of "a ... a" ends the match rather than opening a new one
+bool TokenSearch::Matcher::segmentFound(size_t pattern, size_t segment, size_t start)
+{
+  const Pattern& pat = _search._patterns[pattern];
+  Progress& prog = _progress[pattern];
+  size_t end = start + pat.segments[segment].length - 1;
+  if (segment == 0 && prog.nextSeg <= 1)
+    prog.matchOffset = _offsets[start & _mask];   // restart from the latest opener
+  else if (segment != prog.nextSeg || start < prog.minStart)
+    return false;
+  if (segment + 1 == pat.segments.size())
+  {
+    _found.push_back(SearchMatch{ _file, prog.matchOffset, 0, 0, pattern });
+    prog.nextSeg = 0;
+    return true;
+  }
+  prog.nextSeg = segment + 1;
+  prog.minStart = end + 1;
+  return true;
+}
+
+//----< TokenSearch >------------------------------------------------
+
+TokenSearch::TokenSearch() : _alphabet(1), _maxSegment(1), _compiled(false) {}
+
+//--tokenizes pattern with Toker and splits it into segments and pieces
+size_t TokenSearch::addPattern(const std::string& pattern)
+{
+  if (_compiled)
+    throw(std::logic_error("addPattern after compile"));
+  std::istringstream in(pattern);
+  Toker toker;
+  toker.attach(&in);
+  std::vector<std::vector<std::string>> segments(1);
+  while (true)
+  {
+    std::string tok = toker.getTok();
+    if (tok == "")
+      break;
+    if (tok == "\n")
+      continue;
+    if (tok == "...")
+    {
+      if (segments.back().size() > 0)
+        segments.push_back(std::vector<std::string>());
+      continue;
+    }
+    segments.back().push_back(tok);
+  }
+  if (segments.back().size() == 0)
+    segments.pop_back();
+  if (segments.size() == 0)
+    throw(std::invalid_argument("empty pattern"));
+
+  size_t id = _patterns.size();
+  Pattern pat;
+  pat.text = pattern;
+  for (size_t s = 0; s < segments.size(); ++s)
+  {
+    Segment seg{ segments[s].size(), 0 };
+    std::vector<TokId> run;
+    for (size_t i = 0; i <= segments[s].size(); ++i)
+    {
+      if (i < segments[s].size() && segments[s][i] != "?")
+      {
+        run.push_back(_interner.intern(segments[s][i]));
+        continue;
+      }
+      if (run.size() == 0)
+        continue;
+      _pieces.push_back(Piece{ id, s, seg.pieces++, run.size(), i - run.size() });
+      _pieceToks.push_back(run);
+      run.clear();
+    }
+    if (seg.pieces == 0)
+      throw(std::invalid_argument("pattern segment has only wildcards: " + pattern));
+    _maxSegment = std::max(_maxSegment, seg.length);
+    pat.segments.push_back(seg);
+  }
+  _patterns.push_back(pat);
+  return id;
+}
+
+//--builds the Aho-Corasick automaton and flattens it into a dense table
+void TokenSearch::compile()
+{
+  _alphabet = _interner.size();
+  std::vector<std::map<TokId, size_t>> trie(1);
+  _outputs.assign(1, std::vector<size_t>());
+  for (size_t p = 0; p < _pieces.size(); ++p)
+  {
+    size_t node = 0;
+    for (TokId id : _pieceToks[p])
+    {
+      auto iter = trie[node].find(id);
+      if (iter == trie[node].end())
+      {
+        trie[node][id] = trie.size();
+        node = trie.size();
+        trie.push_back(std::map<TokId, size_t>());
+        _outputs.push_back(std::vector<size_t>());
+      }
+      else
+        node = iter->second;
+    }
+    _outputs[node].push_back(p);
+  }
+
+  std::vector<size_t> fail(trie.size(), 0);
+  _delta.assign(trie.size() * _alphabet, 0);
+  std::queue<size_t> bfs;
+  bfs.push(0);
+  while (!bfs.empty())
+  {
+    size_t node = bfs.front();
+    bfs.pop();
+    for (size_t a = 0; a < _alphabet; ++a)
+    {
+      auto iter = trie[node].find(static_cast<TokId>(a));
+      if (iter == trie[node].end())
+      {
+        if (node != 0)
+          _delta[node * _alphabet + a] = _delta[fail[node] * _alphabet + a];
+        continue;
+      }
+      size_t next = iter->second;
+      fail[next] = (node == 0) ? 0 : _delta[fail[node] * _alphabet + a];
+      auto& inherited = _outputs[fail[next]];
+      _outputs[next].insert(_outputs[next].end(), inherited.begin(), inherited.end());
+      _delta[node * _alphabet + a] = static_cast<TokId>(next);
+      bfs.push(next);
+    }
+  }
+  _compiled = true;
+}
+
+const std::string& TokenSearch::pattern(size_t id) const
+{
+  if (id >= _patterns.size())
+    throw(std::invalid_argument("index out of range"));
+  return _patterns[id].text;
+}
+
+//--matches every pattern against one stream in a single pass
+void TokenSearch::searchStream(std::istream& in, size_t file, std::vector<SearchMatch>& found) const
+{
+  if (!_compiled)
+    throw(std::logic_error("TokenSearch not compiled"));
+  ScannerPool::Lease scanner = ScannerPool::local().acquire(&in);
+  if (!scanner.attached())
+    return;
+  Toker& toker = scanner.toker();
+  Matcher matcher(*this, file, found);
+  while (true)
+  {
+    std::string tok = toker.getTok();
+    if (tok == "")
+      break;
+    if (tok == "\n" || (tok.size() > 1 && tok[0] == '/' && (tok[1] == '/' || tok[1] == '*')))
+      continue;
+    matcher.step(_interner.lookup(tok), toker.tokOffset());
+  }
+}
+
+//--searches one file and resolves its matches to lines and columns;
+//  false, with no matches, if it can't be opened or tokenized
+bool TokenSearch::scanFile(const std::string& path, size_t file, std::vector<SearchMatch>& found) const
+{
+  std::ifstream in(path, std::ios::binary);
+  if (!in.good())
+    return false;
+  size_t before = found.size();
+  try
+  {
+    searchStream(in, file, found);
+  }
+  catch (std::exception&)   // Toker rejects bytes it can't classify, such as a BOM
+  {
+    found.resize(before);
+    return false;
+  }
+  if (found.size() > before)
+  {
+    LineIndex lines(path);
+    for (size_t m = before; m < found.size(); ++m)
+    {
+      TextPos pos = lines.position(found[m].offset);
+      found[m].line = pos.line;
+      found[m].column = pos.column;
+    }
+  }
+  return true;
+}
+
+std::vector<SearchMatch> TokenSearch::searchFile(const std::string& path, size_t file) const
+{
+  if (!_compiled)
+    throw(std::logic_error("TokenSearch not compiled"));
+  std::vector<SearchMatch> found;
+  scanFile(path, file, found);
+  return found;
+}
+
+//--spreads files over worker threads, each with private Toker and results
+std::vector<SearchMatch> TokenSearch::searchFiles(const std::vector<std::string>& files, size_t nThreads,
+  std::vector<size_t>* pUnreadable) const
+{
+  if (!_compiled)
+    throw(std::logic_error("TokenSearch not compiled"));
+  if (nThreads == 0)
+    nThreads = std::max(1u, std::thread::hardware_concurrency());
+  nThreads = std::max(size_t(1), std::min(nThreads, files.size()));
+
+  std::atomic<size_t> next(0);
+  std::vector<std::vector<SearchMatch>> results(nThreads);
+  std::vector<std::vector<size_t>> unreadable(nThreads);
+  auto worker = [&](size_t t) {
+    size_t i;
+    while ((i = next++) < files.size())
+      if (!scanFile(files[i], i, results[t]))
+        unreadable[t].push_back(i);
+  };
+  std::vector<std::thread> threads;
+  for (size_t t = 1; t < nThreads; ++t)
+    threads.push_back(std::thread(worker, t));
+  worker(0);
+  for (auto& thrd : threads)
+    thrd.join();
+
+  std::vector<SearchMatch> found;
+  for (auto& r : results)
+    found.insert(found.end(), r.begin(), r.end());
+  std::sort(found.begin(), found.end(), [](const SearchMatch& a, const SearchMatch& b) {
+    if (a.file != b.file) return a.file < b.file;
+    if (a.offset != b.offset) return a.offset < b.offset;
+    return a.pattern < b.pattern;
+  });
+  if (pUnreadable != nullptr)
+  {
+    pUnreadable->clear();
+    for (auto& u : unreadable)
+      pUnreadable->insert(pUnreadable->end(), u.begin(), u.end());
+    std::sort(pUnreadable->begin(), pUnreadable->end());
+  }
+  return found;
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_TOKENSEARCH
+
+int main()
+{
+  std::vector<std::string> files = {
+    "../Tokenizer/TokenizerTestFile.txt", "../SemiExp/SemiExpTestFile.txt", "../Tokenizer/BomTestFile.txt"
+  };
+  TokenSearch search;
+  search.addPattern("for ( ... ) {");
+  search.addPattern("cout << ?");
+  search.addPattern("class ? : public ?");
+  search.addPattern("# include");
+  search.compile();
+
+  std::cout << "\n  <-----------Token Sequence Search------------> \n";
+  std::vector<size_t> unreadable;
+  for (auto& m : search.searchFiles(files, 0, &unreadable))
+    std::cout << "\n  " << files[m.file] << "(" << m.line << ":" << m.column << "): " << search.pattern(m.pattern);
+  for (size_t file : unreadable)
+    std::cout << "\n  " << files[file] << ": unreadable";
+
+  //--a pattern that opens and closes with the same token
+  TokenSearch same;
+  same.addPattern("a ... a");
+  same.compile();
+  std::istringstream text("a x a a y z a");
+  std::vector<SearchMatch> found;
+  same.searchStream(text, 0, found);
+  std::cout << "\n\n  \"a ... a\" in \"a x a a y z a\": " << found.size() << " matches";
+  for (auto& m : found)
+    std::cout << ", at " << m.offset;
+  std::cout << "\n\n";
+  return 0;
+}
+#endif
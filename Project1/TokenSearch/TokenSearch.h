@@ -0,0 +1,140 @@
+#ifndef TOKENSEARCH_H
+#define TOKENSEARCH_H
+///////////////////////////////////////////////////////////////////////
+// TokenSearch.h - search token-sequence patterns across source files//
+// ver 1.3                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package provides a public TokenSearch class that finds structural
+* patterns, written as token sequences, in the token streams produced by
+* Toker.  A pattern is tokenized with the same Toker rules as the files
+* it is matched against, so "new int [" and "std::cout <<" mean exactly
+* the tokens Toker would return.  Two wildcards are supported:
+*   ?     matches any single token
+*   ...   matches any run of tokens (possibly empty)
+* Wildcards must be separated from neighbouring punctuators by spaces.
+*
+* All patterns are interned into integer token ids and compiled into one
+* Aho-Corasick automaton, so each file is matched in a single pass no
+* matter how many patterns are registered.  Newline and comment tokens
+* are not part of the matched sequence.
+*
+* Matches record the byte offset of their first token.  searchFile()
+* and searchFiles() resolve offsets to line and column with a LineIndex,
+* built only for files that have matches; searchStream() leaves that to
+* the caller.  searchFiles() spreads files over worker threads, each with
+* its own Toker, and returns the matches sorted by file and offset.
+* A file that can't be opened, or holds bytes the Toker rejects such as
+* a UTF-8 byte order mark, has no matches and is listed as unreadable.
+*
+* Public Interface:
+* -----------------
+* TokenSearch search;
+* search.addPattern("new ? [");
+* search.addPattern("lock ( ... )");
+* search.compile();
+* std::vector<size_t> unreadable;
+* std::vector<SearchMatch> found = search.searchFiles(files, 0, &unreadable);
+*
+* Build Process:
+* --------------
+* Required Files:
+*   TokenSearch.h, TokenSearch.cpp, Tokenizer.h, Tokenizer.cpp,
+*   LineIndex.h, LineIndex.cpp, ScannerPool.h, ScannerPool.cpp, SemiExp.h,
+*   SemiExp.cpp, SemiRules.h, SemiRules.cpp
+*
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.3 : 19 Oct 2026
+* - a file the Toker throws on is reported as unreadable instead of
+*   ending the process from a worker thread
+* ver 1.2 : 19 Oct 2026
+* - per-file Tokers come from ScannerPool
+* ver 1.1 : 19 Oct 2026
+* - matches carry byte offsets; lines and columns come from LineIndex
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <iosfwd>
+
+namespace Scanner
+{
+  using TokId = unsigned int;
+
+  //--maps token text to dense integer ids; id 0 means "not interned"
+  class TokenInterner
+  {
+  public:
+    TokId intern(const std::string& tok);
+    TokId lookup(const std::string& tok) const;
+    size_t size() const { return _ids.size() + 1; }
+  private:
+    std::unordered_map<std::string, TokId> _ids;
+  };
+
+  struct SearchMatch
+  {
+    size_t file;      // index into the file list searched
+    size_t offset;    // byte offset of the first matched token
+    size_t line;      // 1-based, 0 until resolved from offset
+    size_t column;    // 1-based, 0 until resolved from offset
+    size_t pattern;   // id returned by addPattern
+  };
+
+  class TokenSearch
+  {
+  public:
+    TokenSearch();
+    size_t addPattern(const std::string& pattern);
+    void compile();
+    const std::string& pattern(size_t id) const;
+    size_t patternCount() const { return _patterns.size(); }
+    void searchStream(std::istream& in, size_t file, std::vector<SearchMatch>& found) const;
+    std::vector<SearchMatch> searchFile(const std::string& path, size_t file = 0) const;
+    std::vector<SearchMatch> searchFiles(const std::vector<std::string>& files, size_t nThreads = 0,
+      std::vector<size_t>* pUnreadable = nullptr) const;
+  private:
+    bool scanFile(const std::string& path, size_t file, std::vector<SearchMatch>& found) const;
+    struct Piece       // run of concrete tokens inside a segment
+    {
+      size_t pattern;
+      size_t segment;
+      size_t index;    // position of this piece within its segment
+      size_t length;   // in tokens
+      size_t offset;   // token offset of the piece from segment start
+    };
+    struct Segment     // tokens between two "..." wildcards
+    {
+      size_t length;
+      size_t pieces;
+    };
+    struct Pattern
+    {
+      std::string text;
+      std::vector<Segment> segments;
+    };
+    class Matcher;
+    std::vector<Pattern> _patterns;
+    std::vector<std::vector<TokId>> _pieceToks;
+    std::vector<Piece> _pieces;
+    TokenInterner _interner;
+    std::vector<TokId> _delta;                 // dense DFA: state * _alphabet + id
+    std::vector<std::vector<size_t>> _outputs; // pieces ending at each state
+    size_t _alphabet;
+    size_t _maxSegment;
+    bool _compiled;
+  };
+}
+#endif
@@ -0,0 +1,51 @@
+#ifndef ITOKSOURCE_H
+#define ITOKSOURCE_H
+///////////////////////////////////////////////////////////////////////
+// ITokSource.h - interface for producers of tokens                  //
+// ver 1.3                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Module Purpose:
+* ===============
+* ITokSource is what SemiExp reads tokens from.  Toker is one; a reader
+* of a TokBroadcast, which replays tokens another thread scanned, is
+* another.  getTok() returns "" once the tokens are exhausted, and
+* tokOffset() the stream offset of the first character of the token
+* getTok() last returned.  cancelled() tells a "" that came from a
+* cancelled or timed-out source apart from the end of the tokens.
+* skipBlock(), called after getTok() returned {, passes over the rest
+* of that block; a source that can't returns false.  tokContinues()
+* is true when the token getTok() last returned is only a piece of one
+* and the next getTok() returns more of it.
+*
+* Maintenance History:
+* ====================
+* ver 1.3 : 19 Oct 2026
+* - added tokContinues(), false unless a source overrides it
+* ver 1.2 : 19 Oct 2026
+* - added skipBlock(), false unless a source overrides it
+* ver 1.1 : 19 Oct 2026
+* - added cancelled(), false unless a source overrides it
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+
+#include <string>
+
+namespace Scanner
+{
+  struct ITokSource
+  {
+    virtual std::string getTok() = 0;
+    virtual size_t tokOffset() = 0;
+    virtual bool cancelled() { return false; }
+    virtual bool tokContinues() { return false; }
+    virtual bool skipBlock(size_t&, bool&) { return false; }
+    virtual ~ITokSource() {};
+  };
+}
+#endif
@@ -1,6 +1,6 @@
 ///////////////////////////////////////////////////////////////////////
 // Tokenizer.cpp - read words from a std::stream                     //
-// ver 3.3                                                           //
+// ver 3.11                                                          //
 // Language:    C++, Visual Studio 2015                              //
 // Application: Parser component, CSE687 - Object Oriented Design    //
 // Source:      Jim Fawcett, Syracuse University, CST 4-187          //
@@ -28,6 +28,30 @@
 *
 * Maintenance History:
 * --------------------
+* ver 3.11 : 19 Oct 2026
+* - added ConsumeState::skipBlock(), a raw scan to the matching brace
+* ver 3.10 : 19 Oct 2026
+* - getChar() counts down to a TokCancel check and throws TokerCancelled
+*   out of any state; Toker::getTok() catches it
+* ver 3.9 : 19 Oct 2026
+* - comments, quoted strings, identifiers and punctuator runs stop at
+*   TokerConfig::maxTokenSize() and continue in the next token, with
+*   Context::continues set in between
+* ver 3.8 : 19 Oct 2026
+* - added TokerCheckpoint, Toker::checkpoint() and Toker::resume()
+* ver 3.7 : 19 Oct 2026
+* - the nine states are members of a ContextWithStates, so a Toker costs
+*   one allocation; Toker::reset() rewinds them for another stream
+* ver 3.6 : 19 Oct 2026
+* - special characters and collectComments read from the Toker's
+*   TokerConfig; the static maps are gone
+* ver 3.5 : 19 Oct 2026
+* - every character is read through ConsumeState::getChar(), which counts
+*   them, so Toker::tokOffset() can report where each token starts
+* ver 3.4 : 19 Oct 2026
+* - scanner state (token, stream, current char, state objects) now lives
+*   in a Context owned by each Toker instead of ConsumeState statics.
+*   The special character tables and collectComments are still shared.
 * ver 3.3 : 08 Feb 2016
 * - added functions for adding special characters and option to include
 *   comments in token. 
@@ -41,169 +65,324 @@
 #include <iostream>
 #include <cctype>
 #include <string>
-#include <map>
+#include <sstream>
+#include <stdexcept>
 
 namespace Scanner
 {
+  class ConsumeState;
+
+  //--scanner state belonging to one Toker, shared by all of its states
+  struct Context
+  {
+    Context(std::shared_ptr<const TokerConfig> pConfig);
+    Context(const Context&) = delete;
+    Context& operator=(const Context&) = delete;
+    virtual ~Context() {}
+    void rewind();
+    std::string token;
+    std::istream* _pIn;
+    int prevChar;
+    int currChar;
+    size_t charCount;   // characters read from _pIn so far
+    size_t tokOffset;   // offset of the first character of token
+    bool started;       // false until the first character is read
+    bool continues;     // token was cut at maxTokenSize; _pState goes on with it
+    TokerCheckpoint restart;     // before the token being scanned
+    const TokCancel* pCancel;
+    size_t untilCheck;           // characters left before pCancel is checked
+    bool cancelled;
+    std::shared_ptr<const TokerConfig> config;
+    ConsumeState* _pState;
+    ConsumeState* _pEatCppComment;
+    ConsumeState* _pEatCComment;
+    ConsumeState* _pEatWhitespace;
+    ConsumeState* _pEatPunctuator;
+    ConsumeState* _pEatAlphanum;
+    ConsumeState* _pEatNewline;
+    ConsumeState* _pEatQuotedString;
+    ConsumeState* _pEatSpecialChar;
+    ConsumeState* _pEatSpecialNewline;
+  };
+
+  const size_t CancelCheckChars = 4096;
+
+  //--thrown by getChar() out of whichever state is running
+  struct TokerCancelled {};
+
   class ConsumeState
   {
   public:
-    ConsumeState();
+    ConsumeState(Context* pContext);
     ConsumeState(const ConsumeState&) = delete;
     ConsumeState& operator=(const ConsumeState&) = delete;
     virtual ~ConsumeState();
-    void attach(std::istream* pIn) { _pIn = pIn; }
+    void attach(std::istream* pIn) { _pContext->_pIn = pIn; }
     virtual void eatChars() = 0;
     void consumeChars() {
-      _pState->eatChars();
-      _pState = nextState();
+      if (!_pContext->continues)
+        markRestart();
+      _pContext->started = true;
+      _pContext->tokOffset = _pContext->charCount - 1;   // currChar is already read
+      _pContext->_pState->eatChars();
+      if (!_pContext->continues)
+        _pContext->_pState = nextState();
+    }
+    //--what checkpoint() would return now, kept in case of cancellation
+    void markRestart() {
+      _pContext->restart = _pContext->started ?
+        TokerCheckpoint{ _pContext->charCount - 1, _pContext->currChar } :
+        TokerCheckpoint{ _pContext->charCount, EOF };
     }
-    bool canRead() { return _pIn->good(); }
-    std::string getTok() { return token; }
-    bool hasTok() { return token.size() > 0; }
+    bool skipBlock(size_t& newlines);
+    bool canRead() { return _pContext->_pIn->good(); }
+    std::string getTok() { return _pContext->token; }
+    bool hasTok() { return _pContext->token.size() > 0; }
+    size_t tokOffset() { return _pContext->tokOffset; }
     ConsumeState* nextState();
-	bool setSpecialSingleChars(std::string ssc);
-	bool setSpecialCharPairs(std::string scp);
-	void setCollectComments(bool value);
-	void setConstructDestructFlag();
   protected:
-	static bool constructorFlag;
-	static bool destructorFlag;
-	static std::map<char, int> oneCharTokens;
-	static std::map<std::string, int> twoCharTokens;
-    static std::string token;
-    static std::istream* _pIn;
-    static int prevChar;
-    static int currChar;
-	static bool collectComments;
-    static ConsumeState* _pState;
-    static ConsumeState* _pEatCppComment;
-    static ConsumeState* _pEatCComment;
-    static ConsumeState* _pEatWhitespace;
-    static ConsumeState* _pEatPunctuator;
-    static ConsumeState* _pEatAlphanum;
-    static ConsumeState* _pEatNewline;
-	static ConsumeState* _pEatQuotedString;
-	static ConsumeState* _pEatSpecialChar;
-	static ConsumeState* _pEatSpecialNewline;
+    int getChar() {
+      ++_pContext->charCount;
+      if (--_pContext->untilCheck == 0)
+        checkCancel();
+      return _pContext->_pIn->get();
+    }
+    //--getChar() straight from the streambuf, for skipBlock()
+    int getRawChar(std::streambuf* pBuf) {
+      ++_pContext->charCount;
+      if (--_pContext->untilCheck == 0)
+        checkCancel();
+      return pBuf->sbumpc();
+    }
+    void checkCancel() {
+      _pContext->untilCheck = CancelCheckChars;
+      if (_pContext->pCancel != nullptr && _pContext->pCancel->expired())
+        throw TokerCancelled();
+    }
+    const TokerConfig& config() { return *_pContext->config; }
+    //--true if the token has reached the size cap with input still to
+    //  come; the state then sets continues and returns the token so far
+    bool full() {
+      size_t cap = config().maxTokenSize();
+      return cap != 0 && _pContext->token.size() >= cap && _pContext->_pIn->good();
+    }
+    //--full() and, if so, marks the token as continuing
+    bool cut() {
+      if (!full())
+        return false;
+      _pContext->continues = true;
+      return true;
+    }
+    //--clears the continues flag, returning whether it was set
+    bool resuming() {
+      bool was = _pContext->continues;
+      _pContext->continues = false;
+      return was;
+    }
+    Context* _pContext;
   };
 }
 
 using namespace Scanner;
 
-std::map<char, int> ConsumeState::oneCharTokens = { {'<', NULL}, {'>', NULL}, {'[', NULL}, {']', NULL},
-														    {'(', NULL}, {')', NULL}, {'{', NULL}, {'}', NULL},
-															{':', NULL}, {'=', NULL}, {'+', NULL}, {'-', NULL},
-															{'*', NULL}, {'*', NULL}, {'\n', NULL} };
-
-std::map<std::string, int> ConsumeState::twoCharTokens = { {"<<", NULL}, {">>", NULL}, {"::", NULL}, {"++", NULL},
-																   {"--", NULL}, {"==", NULL}, {"+=", NULL}, {"-=", NULL},
-																   {"*=", NULL}, };
-bool ConsumeState :: constructorFlag = true;
-bool ConsumeState :: destructorFlag = true;
-std::string ConsumeState::token;
-std::istream* ConsumeState::_pIn = nullptr;
-int ConsumeState::prevChar;
-int ConsumeState::currChar;
-bool ConsumeState::collectComments = false;
-ConsumeState* ConsumeState::_pState = nullptr;
-ConsumeState* ConsumeState::_pEatCppComment = nullptr;
-ConsumeState* ConsumeState::_pEatCComment = nullptr;
-ConsumeState* ConsumeState::_pEatWhitespace = nullptr;
-ConsumeState* ConsumeState::_pEatPunctuator = nullptr;
-ConsumeState* ConsumeState::_pEatAlphanum = nullptr;
-ConsumeState* ConsumeState::_pEatQuotedString = nullptr;
-ConsumeState* ConsumeState::_pEatSpecialChar = nullptr;
-ConsumeState* ConsumeState::_pEatSpecialNewline = nullptr;
-ConsumeState* ConsumeState::_pEatNewline;
-
 void testLog(const std::string& msg);
 
-//--adds single special characters inside the default's list
-bool ConsumeState :: setSpecialSingleChars(std::string ssc)
+//----< TokerConfig >------------------------------------------------
+
+TokerConfig::TokerConfig() : _collectComments(false), _maxTokenSize(0)
 {
-		if (oneCharTokens.count(ssc[0]) > 0)   //checks if the string is already present.
-			return false;
-		oneCharTokens[ssc[0]] = 1;
-		return true;
+  for (char ch : std::string("<>[](){}:=+-*\n"))
+    _singles.set(static_cast<unsigned char>(ch));
+  for (auto pair : { "<<", ">>", "::", "++", "--", "==", "+=", "-=", "*=" })
+    addSpecialCharPair(pair);
 }
 
-void ConsumeState :: setConstructDestructFlag()
+//--adds a single special character to the table
+bool TokerConfig::addSpecialSingleChar(char ch)
 {
-	constructorFlag = true;
-	destructorFlag = true;
+  if (_singles[static_cast<unsigned char>(ch)])   //checks if the char is already present.
+    return false;
+  _singles.set(static_cast<unsigned char>(ch));
+  return true;
 }
 
-//--adds special characters pairs inside the default's list
-bool ConsumeState :: setSpecialCharPairs(std::string scp)
+//--adds a special character pair to the table
+bool TokerConfig::addSpecialCharPair(const std::string& pair)
 {
-	if (twoCharTokens.count(scp) > 0)
-		return false;
-	twoCharTokens[scp] = 1;
-	return true;
+  if (pair.size() != 2 || isSpecialCharPair(pair[0], pair[1]))
+    return false;
+  _pairs.set((pair[0] & 0xff) << 8 | (pair[1] & 0xff));
+  return true;
 }
 
 //--sets whether to include comments in tokens
-void ConsumeState :: setCollectComments(bool value)
+void TokerConfig::setCollectComments(bool value)
 {
-	if (value)
-		collectComments = true;
-	else
-		collectComments = false;
+  _collectComments = value;
+}
+
+//--caps the size of comment, quoted string, identifier and punctuator
+//  tokens; longer ones arrive in pieces of this size.  0, the default,
+//  means no cap
+void TokerConfig::setMaxTokenSize(size_t size)
+{
+  _maxTokenSize = size;
+}
+
+//--one default config, built on first use, shared by every default Toker
+std::shared_ptr<const TokerConfig> TokerConfig::defaults()
+{
+  static const std::shared_ptr<const TokerConfig> config = std::make_shared<TokerConfig>();
+  return config;
 }
 
 //--sets the state of the object depending upon the current character of input stream
 ConsumeState* ConsumeState::nextState()
 {
-  if (!(_pIn->good()))
+  if (!(_pContext->_pIn->good()))
     return nullptr;
 
-  int chNext = _pIn->peek();
+  int chNext = _pContext->_pIn->peek();
 
   if (chNext == EOF)
-    _pIn->clear();   // _pIn->good() will return false.  clear() restores state to good
+    _pContext->_pIn->clear();   // _pIn->good() will return false.  clear() restores state to good
 
-  if (currChar == '\\' && chNext == 'n')
-	  return _pEatSpecialNewline;
-  if (currChar == '\"' || currChar == '\'')
-	  return _pEatQuotedString;
+  if (_pContext->currChar == '\\' && chNext == 'n')
+	  return _pContext->_pEatSpecialNewline;
+  if (_pContext->currChar == '\"' || _pContext->currChar == '\'')
+	  return _pContext->_pEatQuotedString;
 
-  if (std::isspace(currChar) && currChar != '\n')
-    return _pEatWhitespace;
+  if (std::isspace(_pContext->currChar) && _pContext->currChar != '\n')
+    return _pContext->_pEatWhitespace;
 
-  if (currChar == '/' && chNext == '/')
-    return _pEatCppComment;
+  if (_pContext->currChar == '/' && chNext == '/')
+    return _pContext->_pEatCppComment;
 
-  if (currChar == '/' && chNext == '*')
-    return _pEatCComment;
+  if (_pContext->currChar == '/' && chNext == '*')
+    return _pContext->_pEatCComment;
 
-  if (currChar == '\n')
-    return _pEatNewline;
+  if (_pContext->currChar == '\n')
+    return _pContext->_pEatNewline;
 
-  if (oneCharTokens.count(currChar) > 0)
-	  return _pEatSpecialChar;
+  if (config().isSpecialSingleChar(_pContext->currChar))
+	  return _pContext->_pEatSpecialChar;
 
-  if (std::isalnum(currChar))
-    return _pEatAlphanum;
+  if (std::isalnum(_pContext->currChar))
+    return _pContext->_pEatAlphanum;
 
-  if (ispunct(currChar))
-    return _pEatPunctuator;
+  if (ispunct(_pContext->currChar))
+    return _pContext->_pEatPunctuator;
 
-  if (!_pIn->good())
-    return _pEatWhitespace;
+  if (!_pContext->_pIn->good())
+    return _pContext->_pEatWhitespace;
   throw(std::logic_error("invalid type"));
 }
 
+//--reads past the } that closes a { just returned, counting braces in
+//  code but not in comments or quoted text, where quotes open and close
+//  as getTok() would see them.  newlines counts the newlines in tokens
+//  getTok() would have returned.  Works on the streambuf a character at
+//  a time, without forming tokens, and leaves the Toker as if it had
+//  just returned the }.  Returns false if the input ends first
+bool ConsumeState::skipBlock(size_t& newlines)
+{
+  enum { Code, LineComment, BlockComment, Quoted } mode = Code;
+  std::streambuf* pBuf = _pContext->_pIn->rdbuf();
+  markRestart();
+  size_t depth = 1, lines = 0;
+  bool commentLines = config().collectComments();   // else comments hide theirs
+  bool punctuator = false;   // in a run EatPunctuator would take whole
+  bool inBetween = true, backSlashIsComing = false, backSlashCame = true;
+  int ch = _pContext->started ? _pContext->currChar : getRawChar(pBuf);
+  _pContext->started = true;
+  while (ch != EOF)
+  {
+    if (mode == Code)
+    {
+      if (!punctuator || !ispunct(ch) || config().isSpecialSingleChar(ch))
+      {
+        punctuator = false;
+        if (ch == '{')
+          ++depth;
+        else if (ch == '}' && --depth == 0)
+          break;
+        else if (ch == '"' || ch == '\'')
+        {
+          mode = Quoted;
+          inBetween = true, backSlashIsComing = false, backSlashCame = true;
+        }
+        else if (ch == '/' && pBuf->sgetc() == '/')
+          mode = LineComment;
+        else if (ch == '/' && pBuf->sgetc() == '*')
+          mode = BlockComment;
+        else if (ispunct(ch) && !config().isSpecialSingleChar(ch))
+          punctuator = true;
+      }
+    }
+    else if (mode == LineComment)
+    {
+      if (ch == '\n')
+        mode = Code;
+    }
+    else if (mode == BlockComment)
+    {
+      if (ch == '*' && pBuf->sgetc() == '/')   // as in EatCComment, /*/ is whole
+      {
+        mode = Code;
+        getRawChar(pBuf);
+        if (commentLines)
+          getRawChar(pBuf);   // EatCComment drops one more when collecting
+      }
+      else if (ch == '\n' && !commentLines)
+        ch = 0;
+    }
+    else   // Quoted, with escapes as EatQuotedString reads them
+    {
+      int next = pBuf->sgetc();
+      if (ch == '\\' && next == '\\')
+      {
+        if (backSlashCame)
+          backSlashIsComing = true, backSlashCame = false;
+        else if (backSlashIsComing)
+          backSlashCame = true, backSlashIsComing = false;
+      }
+      else if (ch == '\\' && (next == '"' || next == '\''))
+        inBetween = !backSlashCame;
+      else if (ch == '"' || ch == '\'')   // either one closes
+      {
+        if (inBetween)
+          mode = Code;
+        inBetween = true;
+      }
+    }
+    if (ch == '\n')
+      ++lines;
+    ch = getRawChar(pBuf);
+  }
+  newlines = lines;
+  _pContext->token.clear();
+  if (ch == EOF)
+  {
+    _pContext->_pIn->setstate(std::ios::eofbit | std::ios::failbit);
+    _pContext->currChar = EOF;
+    return false;
+  }
+  _pContext->currChar = getChar();
+  _pContext->_pState = nextState();
+  return true;
+}
+
 class EatSpecialNewLine : public ConsumeState
 {
 public:
+	EatSpecialNewLine(Context* pContext) : ConsumeState(pContext) {}
 	virtual void eatChars()
 	{
-		token.clear();
+		_pContext->token.clear();
 		//std::cout << "\n  eating alphanum";
-		token += currChar;
-		token += _pIn->get();
-		currChar = _pIn->get();
+		_pContext->token += _pContext->currChar;
+		_pContext->token += getChar();
+		_pContext->currChar = getChar();
 		/*if (!_pIn->good())  // end of stream
 			return;
 		currChar = _pIn->get();
@@ -221,20 +400,19 @@ public:
 class EatSpecialChar : public ConsumeState
 {
 	public:
+		EatSpecialChar(Context* pContext) : ConsumeState(pContext) {}
 		virtual void eatChars()
 		{
-			token.clear();
-			std::string comparatorToken;
-			token += currChar;
-			comparatorToken += currChar;
-			currChar = _pIn->get();
-			if (!_pIn->good())
+			_pContext->token.clear();
+			int first = _pContext->currChar;
+			_pContext->token += _pContext->currChar;
+			_pContext->currChar = getChar();
+			if (!_pContext->_pIn->good())
 				return;
-			comparatorToken += currChar;
-			if (twoCharTokens.count(comparatorToken) > 0)
+			if (config().isSpecialCharPair(first, _pContext->currChar))
 			{
-				token += currChar;
-				currChar = _pIn->get();
+				_pContext->token += _pContext->currChar;
+				_pContext->currChar = getChar();
 			}
 		}
 };
@@ -243,54 +421,67 @@ class EatSpecialChar : public ConsumeState
 class EatQuotedString : public ConsumeState
 {
 public:
+	EatQuotedString(Context* pContext) : ConsumeState(pContext) {}
 	virtual void eatChars()
 	{
-		bool quotesOpen = true, inBetween = true, backSlashIsComing = false, backSlashCame = true;
-		token.clear();
-		token += currChar;
+		bool quotesOpen = true, inBetween = _inBetween, backSlashIsComing = _backSlashIsComing, backSlashCame = _backSlashCame;
+		_pContext->token.clear();
+		if (resuming())   // currChar is already in the previous piece
+			_pContext->tokOffset = _pContext->charCount;
+		else
+		{
+			inBetween = true, backSlashIsComing = false, backSlashCame = true;
+			_pContext->token += _pContext->currChar;
+		}
 		do
 		{
-			if (!_pIn->good())  // end of stream
+			if (full())
+			{
+				_inBetween = inBetween, _backSlashIsComing = backSlashIsComing, _backSlashCame = backSlashCame;
+				_pContext->continues = true;
 				return;
-			currChar = _pIn->get();
-			if (currChar == '\\' && _pIn->peek() == '\\')  //if its a escape sequence for backslash
+			}
+			if (!_pContext->_pIn->good())  // end of stream
+				return;
+			_pContext->currChar = getChar();
+			if (_pContext->currChar == '\\' && _pContext->_pIn->peek() == '\\')  //if its a escape sequence for backslash
 			{
 				if (backSlashCame)
 				{
 					backSlashIsComing = true;
 					backSlashCame = false;
-					token += currChar;
+					_pContext->token += _pContext->currChar;
 				}
 				else
 				{
 					if (backSlashIsComing)
 					{
 						backSlashCame = true;
-						token += currChar;
+						_pContext->token += _pContext->currChar;
 						backSlashIsComing = false;
 					}
 				}
 			}
-			else if ((currChar == '\\' && (_pIn->peek() == '"' || _pIn->peek() == '\'')))
+			else if ((_pContext->currChar == '\\' && (_pContext->_pIn->peek() == '"' || _pContext->_pIn->peek() == '\'')))
 				checkForBackSlash(backSlashCame, inBetween);    //1. Refactored to reduce lines
 			else
 				checkForClosingQuote(quotesOpen, inBetween);  //2. Refactored to reduce lines
 		} while (quotesOpen);
-		token += currChar;
-		currChar = _pIn->get();
-		_pState = nextState();
+		_pContext->token += _pContext->currChar;
+		_pContext->currChar = getChar();
+		_pContext->_pState = nextState();
 	}
 	void checkForClosingQuote(bool& quotesOpen, bool& inBetween)  //checks if the quotes is getting closed
 	{
-		if (!(currChar == '"' || currChar == '\''))
-			token += currChar;
+		if (!(_pContext->currChar == '"' || _pContext->currChar == '\''))
+			_pContext->token += _pContext->currChar;
 		else
 		{
 			if (inBetween)
 				quotesOpen = false;
 			else
 			{
-				token += currChar;
+				_pContext->token += _pContext->currChar;
 				inBetween = true;
 			}
 		}
@@ -300,14 +491,16 @@ public:
 		if (backSlashCame)
 		{
 			inBetween = false;
-			token += currChar;
+			_pContext->token += _pContext->currChar;
 		}
 		else
 		{
-			token += currChar;
+			_pContext->token += _pContext->currChar;
 			inBetween = true;
 		}
 	}
+private:
+	bool _inBetween = true, _backSlashIsComing = false, _backSlashCame = true;   // kept across pieces
 };
 
 //--Here eatChars() behaviour changes to omit all the whitespaces 
@@ -315,15 +508,16 @@ public:
 class EatWhitespace : public ConsumeState
 {
 public:
+  EatWhitespace(Context* pContext) : ConsumeState(pContext) {}
   virtual void eatChars()
   {
-    token.clear();
+    _pContext->token.clear();
     //std::cout << "\n  eating whitespace";
     do {
-      if (!_pIn->good())  // end of stream
+      if (!_pContext->_pIn->good())  // end of stream
         return;
-      currChar = _pIn->get();
-    } while (std::isspace(currChar) && currChar != '\n');
+      _pContext->currChar = getChar();
+    } while (std::isspace(_pContext->currChar) && _pContext->currChar != '\n');
   }
 };
 
@@ -333,16 +527,23 @@ public:
 class EatCppComment : public ConsumeState
 {
 public:
+  EatCppComment(Context* pContext) : ConsumeState(pContext) {}
   virtual void eatChars()
   {
-    token.clear();
+    _pContext->token.clear();
+    resuming();   // a piece starts on currChar like a whole comment does
     do {
-		if (collectComments)
-			token += currChar;
-		if (!_pIn->good())  // end of stream
+		if (config().collectComments())
+			_pContext->token += _pContext->currChar;
+		if (!_pContext->_pIn->good())  // end of stream
 		    return;
-		currChar = _pIn->get();
-	} while (currChar != '\n');
+		_pContext->currChar = getChar();
+		if (_pContext->currChar != '\n' && full())
+		{
+			_pContext->continues = true;
+			return;
+		}
+	} while (_pContext->currChar != '\n');
   }
 };
 
@@ -351,23 +552,30 @@ public:
 class EatCComment : public ConsumeState
 {
 public:
+  EatCComment(Context* pContext) : ConsumeState(pContext) {}
   virtual void eatChars()
   {
-    token.clear();
+    _pContext->token.clear();
+    resuming();
 	do {
-		if (!_pIn->good())  // end of stream
+		if (!_pContext->_pIn->good())  // end of stream
 			return;
-		if (collectComments)
-			token += currChar;
-      currChar = _pIn->get();
-    } while (!(currChar == '*' && _pIn->peek() == '/'));
-	if (collectComments)
+		if (config().collectComments())
+			_pContext->token += _pContext->currChar;
+      _pContext->currChar = getChar();
+      if (full() && !(_pContext->currChar == '*' && _pContext->_pIn->peek() == '/'))
+      {
+        _pContext->continues = true;
+        return;
+      }
+    } while (!(_pContext->currChar == '*' && _pContext->_pIn->peek() == '/'));
+	if (config().collectComments())
 	{
-		token += currChar;
-		token += _pIn->get();
+		_pContext->token += _pContext->currChar;
+		_pContext->token += getChar();
 	}
-    _pIn->get();
-    currChar = _pIn->get();
+    getChar();
+    _pContext->currChar = getChar();
   }
 };
 
@@ -375,16 +583,18 @@ public:
 class EatPunctuator : public ConsumeState
 {
 public:
+  EatPunctuator(Context* pContext) : ConsumeState(pContext) {}
   virtual void eatChars()
   {
-    token.clear();
+    _pContext->token.clear();
+    resuming();
     //std::cout << "\n  eating punctuator";
     do {
-      token += currChar;
-      if (!_pIn->good())  // end of stream
+      _pContext->token += _pContext->currChar;
+      if (!_pContext->_pIn->good())  // end of stream
         return;
-      currChar = _pIn->get();
-    } while (ispunct(currChar) && (!((oneCharTokens.count(currChar) > 0) || (currChar == '\\' && _pIn->peek() == 'n'))));
+      _pContext->currChar = getChar();
+    } while (ispunct(_pContext->currChar) && (!(config().isSpecialSingleChar(_pContext->currChar) || (_pContext->currChar == '\\' && _pContext->_pIn->peek() == 'n'))) && !cut());
   }
 };
 
@@ -392,16 +602,18 @@ public:
 class EatAlphanum : public ConsumeState
 {
 public:
+  EatAlphanum(Context* pContext) : ConsumeState(pContext) {}
   virtual void eatChars()
   {
-    token.clear();
+    _pContext->token.clear();
+    resuming();
     //std::cout << "\n  eating alphanum";
     do {
-      token += currChar;
-      if (!_pIn->good())  // end of stream
+      _pContext->token += _pContext->currChar;
+      if (!_pContext->_pIn->good())  // end of stream
         return;
-      currChar = _pIn->get();
-    } while (isalnum(currChar));
+      _pContext->currChar = getChar();
+    } while (isalnum(_pContext->currChar) && !cut());
   }
 };
 
@@ -409,61 +621,91 @@ public:
 class EatNewline : public ConsumeState
 {
 public:
+  EatNewline(Context* pContext) : ConsumeState(pContext) {}
   virtual void eatChars()
   {
-    token.clear();
+    _pContext->token.clear();
     //std::cout << "\n  eating alphanum";
-    token += currChar;
-    if (!_pIn->good())  // end of stream
+    _pContext->token += _pContext->currChar;
+    if (!_pContext->_pIn->good())  // end of stream
       return;
-    currChar = _pIn->get();
+    _pContext->currChar = getChar();
   }
 };
 
 
 
-ConsumeState::ConsumeState()
+ConsumeState::ConsumeState(Context* pContext) : _pContext(pContext) {}
+
+ConsumeState::~ConsumeState() {}
+
+Context::Context(std::shared_ptr<const TokerConfig> pConfig)
+  : _pIn(nullptr), prevChar(0), currChar(0), charCount(0), tokOffset(0), started(false), continues(false),
+    restart{ 0, EOF }, pCancel(nullptr), untilCheck(CancelCheckChars), cancelled(false), config(pConfig)
 {
-  if (constructorFlag)
-  {
-    constructorFlag = false;
-    _pEatAlphanum = new EatAlphanum();
-    _pEatCComment = new EatCComment();
-    _pEatCppComment = new EatCppComment();
-    _pEatPunctuator = new EatPunctuator();
-    _pEatWhitespace = new EatWhitespace();
-    _pEatNewline = new EatNewline();
-	_pEatQuotedString = new EatQuotedString();
-	_pEatSpecialChar = new EatSpecialChar();
-	_pEatSpecialNewline = new EatSpecialNewLine();
-    _pState = _pEatWhitespace;
-  }
+  if (config == nullptr)
+    throw(std::invalid_argument("null TokerConfig"));
+}
+
+//--returns to the state of a newly constructed Context, keeping buffers
+void Context::rewind()
+{
+  token.clear();
+  _pIn = nullptr;
+  prevChar = 0;
+  currChar = 0;
+  charCount = 0;
+  tokOffset = 0;
+  started = false;
+  continues = false;
+  restart = TokerCheckpoint{ 0, EOF };
+  untilCheck = CancelCheckChars;
+  cancelled = false;
+  _pState = _pEatWhitespace;
 }
 
-ConsumeState::~ConsumeState()
+//--each Toker's Context holds its own states inline, so Tokers never share
+//  scanner state and building one takes a single allocation
+struct ContextWithStates : public Context
 {
-  static bool first = true;
-  if (destructorFlag)
+  ContextWithStates(std::shared_ptr<const TokerConfig> pConfig)
+    : Context(pConfig), eatCppComment(this), eatCComment(this), eatWhitespace(this),
+      eatPunctuator(this), eatAlphanum(this), eatNewline(this), eatQuotedString(this),
+      eatSpecialChar(this), eatSpecialNewline(this)
   {
-    destructorFlag = false;
-    delete _pEatAlphanum;
-    delete _pEatCComment;
-    delete _pEatCppComment;
-    delete _pEatPunctuator;
-    delete _pEatWhitespace;
-    delete _pEatNewline;
-	delete _pEatQuotedString;
-	delete _pEatSpecialChar;
-	delete _pEatSpecialNewline;
+    _pEatCppComment = &eatCppComment;
+    _pEatCComment = &eatCComment;
+    _pEatWhitespace = &eatWhitespace;
+    _pEatPunctuator = &eatPunctuator;
+    _pEatAlphanum = &eatAlphanum;
+    _pEatNewline = &eatNewline;
+    _pEatQuotedString = &eatQuotedString;
+    _pEatSpecialChar = &eatSpecialChar;
+    _pEatSpecialNewline = &eatSpecialNewline;
+    _pState = _pEatWhitespace;
   }
+  EatCppComment eatCppComment;
+  EatCComment eatCComment;
+  EatWhitespace eatWhitespace;
+  EatPunctuator eatPunctuator;
+  EatAlphanum eatAlphanum;
+  EatNewline eatNewline;
+  EatQuotedString eatQuotedString;
+  EatSpecialChar eatSpecialChar;
+  EatSpecialNewLine eatSpecialNewline;
+};
+
+Toker::Toker() : _pContext(new ContextWithStates(TokerConfig::defaults()))
+{
+  pConsumer = _pContext->_pEatWhitespace;
 }
 
-Toker::Toker() : pConsumer(new EatWhitespace()) 
+Toker::Toker(std::shared_ptr<const TokerConfig> config) : _pContext(new ContextWithStates(config))
 {
-	pConsumer->setConstructDestructFlag();
+  pConsumer = _pContext->_pEatWhitespace;
 }
 
-Toker::~Toker() { delete pConsumer; }
+Toker::~Toker() { delete _pContext; }
 
 bool Toker::attach(std::istream* pIn)
 {
@@ -475,47 +717,176 @@ bool Toker::attach(std::istream* pIn)
   return false;
 }
 
+//--rewinds all scanner state and starts over on pIn, reusing this
+//  Toker's states and token buffer; a TokCancel is dropped too
+bool Toker::reset(std::istream* pIn)
+{
+  _pContext->rewind();
+  _pContext->pCancel = nullptr;
+  return attach(pIn);
+}
+
+//--where a resumed Toker would pick up: the character read ahead after
+//  the last token, which has not been tokenized yet
+TokerCheckpoint Toker::checkpoint()
+{
+  if (_pContext->cancelled)
+    return _pContext->restart;
+  if (_pContext->continues)
+    throw(std::logic_error("checkpoint inside a token cut at maxTokenSize"));
+  if (!_pContext->started)   // nothing read ahead since attach or resume
+    return TokerCheckpoint{ _pContext->charCount, EOF };
+  return TokerCheckpoint{ _pContext->charCount - 1, _pContext->currChar };
+}
+
+//--restarts at cp on pIn, which must hold the same bytes up to cp.offset.
+//  Starting afresh on the lookahead character reaches the same state the
+//  checkpointed Toker would have; returns false if pIn can't seek there
+//  or holds a different character
+bool Toker::resume(std::istream* pIn, const TokerCheckpoint& cp)
+{
+  _pContext->rewind();
+  if (pIn == nullptr)
+    return false;
+  pIn->clear();
+  pIn->seekg(static_cast<std::streamoff>(cp.offset));
+  if (!pIn->good())
+    return false;
+  if (cp.lookahead != EOF && pIn->peek() != (cp.lookahead & 0xff))
+    return false;
+  _pContext->charCount = cp.offset;
+  return attach(pIn);
+}
+
+std::string TokerCheckpoint::serialize() const
+{
+  return "toker " + std::to_string(offset) + " " + std::to_string(lookahead);
+}
+
+bool TokerCheckpoint::parse(const std::string& text, TokerCheckpoint& cp)
+{
+  std::istringstream in(text);
+  std::string tag;
+  TokerCheckpoint parsed;
+  if (!(in >> tag >> parsed.offset >> parsed.lookahead) || tag != "toker")
+    return false;
+  cp = parsed;
+  return true;
+}
+
+//--true if the last token was cut at the config's maxTokenSize(); the
+//  next getTok() returns more of it
+bool Toker::tokContinues() { return _pContext->continues; }
+
+//--replaces this Toker's config; takes effect from the next character
+void Toker::setConfig(std::shared_ptr<const TokerConfig> config)
+{
+  if (config == nullptr)
+    throw(std::invalid_argument("null TokerConfig"));
+  _pContext->config = config;
+}
+
 std::string Toker::getTok()
 {
-  while(true) 
+  if (_pContext->cancelled)
+    return "";
+  try
   {
-    if (!pConsumer->canRead())
-      return "";
-    pConsumer->consumeChars();
-    if (pConsumer->hasTok())
-      break;
+    while (true)
+    {
+      if (!pConsumer->canRead())
+        return "";
+      pConsumer->consumeChars();
+      if (pConsumer->hasTok())
+        break;
+    }
+  }
+  catch (TokerCancelled&)
+  {
+    _pContext->cancelled = true;
+    _pContext->token.clear();
+    return "";
   }
   return pConsumer->getTok();
 }
 
 
-bool Toker::canRead() { return pConsumer->canRead(); }
+bool Toker::canRead() { return !_pContext->cancelled && pConsumer->canRead(); }
+
+//--checks pCancel every few thousand characters; the Toker stays
+//  cancelled until reset() or resume()
+void Toker::setCancel(const TokCancel* pCancel) { _pContext->pCancel = pCancel; }
 
-//--adds special characters to the default maintained list 'oneCharTokens'
+bool Toker::cancelled() { return _pContext->cancelled; }
+
+//--call just after getTok() returned {; skips to just past its }, which
+//  getTok() then does not return.  closed is false if the input ended
+//  first or the Toker was cancelled
+bool Toker::skipBlock(size_t& newlines, bool& closed)
+{
+  newlines = 0;
+  closed = false;
+  if (_pContext->continues)
+    return false;
+  if (_pContext->cancelled || !pConsumer->canRead())
+    return true;
+  try
+  {
+    closed = pConsumer->skipBlock(newlines);
+  }
+  catch (TokerCancelled&)
+  {
+    _pContext->cancelled = true;
+    newlines = 0;
+  }
+  return true;
+}
+
+bool TokCancel::expired() const
+{
+  if (_cancelled)
+    return true;
+  Clock::rep deadline = _deadline;
+  return deadline != 0 && Clock::now().time_since_epoch().count() >= deadline;
+}
+
+//--offset, in characters read from the attached stream, of the first
+//  character of the token most recently returned by getTok()
+size_t Toker::tokOffset() { return pConsumer->tokOffset(); }
+
+//--adds a special character to this Toker's config; shared configs
+//  are copied first, never changed
 bool Toker :: setSpecialSingleChars(std::string ssc)
 {
-	std::cout << "\n\n ::Special Single Character \'" << ssc << "\' added to the defaults.";
-	return pConsumer->setSpecialSingleChars(ssc);
+	if (ssc.size() == 0 || _pContext->config->isSpecialSingleChar(ssc[0]))
+		return false;
+	auto config = std::make_shared<TokerConfig>(*_pContext->config);
+	config->addSpecialSingleChar(ssc[0]);
+	_pContext->config = config;
+	return true;
 }
 
-//--adds special characters to the default maintained list 'twoCharTokens'
+//--adds a special character pair to this Toker's config
 bool Toker :: setSpecialCharPairs(std::string scp)
 {
-	std::cout << "\n\n ::Special Character Pair \"" << scp << "\" added to the defaults.";
-	return pConsumer->setSpecialCharPairs(scp);
+	auto config = std::make_shared<TokerConfig>(*_pContext->config);
+	if (!config->addSpecialCharPair(scp))
+		return false;
+	_pContext->config = config;
+	return true;
 }
 
-//--sets the collectComments flag to true or false indicating whether 
-//  or not to tokenize the comments 
+//--sets whether or not this Toker tokenizes the comments
 void Toker::setCollectComments(bool value)
 {
-	pConsumer->setCollectComments(value);	
+	if (_pContext->config->collectComments() == value)
+		return;
+	auto config = std::make_shared<TokerConfig>(*_pContext->config);
+	config->setCollectComments(value);
+	_pContext->config = config;
 }
 
-void Toker :: setConstructorDestructorflag()
-{
-	pConsumer->setConstructDestructFlag();
-}
+std::shared_ptr<const TokerConfig> Toker::config() const { return _pContext->config; }
 
 void testLog(const std::string& msg)
 {
@@ -543,11 +914,14 @@ int main()
     std::cout << "\n  can't open " << fileSpec << "\n\n";
     return 1;
   }
-  Toker toker;
+  auto config = std::make_shared<TokerConfig>();
+  config->addSpecialSingleChar('/');
+  config->addSpecialCharPair("/=");
+  config->setCollectComments(true);  //testing comments
+  std::cout << "\n\n ::Special Single Character \'/\' added to the defaults.";
+  std::cout << "\n\n ::Special Character Pair \"/=\" added to the defaults.";
+  Toker toker(config);
   toker.attach(&in);
-  toker.setSpecialSingleChars("/");  
-  toker.setSpecialCharPairs("/=");
-  toker.setCollectComments(true);  //testing comments
 
   do
   {
@@ -2,7 +2,7 @@
 #define TOKENIZER_H
 ///////////////////////////////////////////////////////////////////////
 // Tokenizer.h - read words from a std::stream                       //
-// ver 3.5                                                           //
+// ver 4.5                                                           //
 // Language:    C++, Visual Studio 2015                              //
 // Application: Parser component, CSE687 - Object Oriented Design    //
 // Source:      Jim Fawcett, Syracuse University, CST 4-187          //
@@ -21,13 +21,94 @@
  * This is a new version, based on the State Design Pattern.  Older versions
  * exist, based on an informal state machine design.
  *
+ * Which characters form single and paired punctuator tokens, and whether
+ * comments are returned, is held in a TokerConfig.  A config is filled in
+ * once and then handed to Tokers as a shared_ptr<const TokerConfig>, so
+ * any number of Tokers, on any threads, read the same tables without
+ * locking.  The Toker setters leave shared configs alone: they copy the
+ * Toker's config, change the copy and use it from then on.
+ *
+ *   auto config = std::make_shared<TokerConfig>();
+ *   config->addSpecialSingleChar('@');
+ *   config->setCollectComments(true);
+ *   Toker toker(config);        // every Toker built from config agrees
+ *
+ * Between tokens the scanner holds no state but the one character it has
+ * read ahead; which state handles it is decided from that character and
+ * the next.  checkpoint() records the offset of that character, and
+ * resume() restarts there on a stream holding the same bytes, so a
+ * checkpoint is valid across processes and after data is appended.
+ *
+ * A config may cap token size with setMaxTokenSize().  A comment, quoted
+ * string, identifier or punctuator run that reaches the cap is returned
+ * in pieces; tokContinues() is true after every piece but the last, and
+ * each piece's tokOffset() is where it starts.  The Toker never holds
+ * more than one piece, so memory stays bounded however long the token.
+ *
+ * A Toker given a TokCancel checks it every few thousand characters,
+ * inside comments and quoted strings too.  Once it is cancelled or its
+ * deadline passes, getTok() returns "" and cancelled() is true; the
+ * unfinished token is dropped and checkpoint() is where it began, so
+ * resume() picks up with nothing lost.  A token that was being returned
+ * in pieces starts over, and its earlier pieces come again.  A token
+ * longer than one budget can scan never finishes this way, so budgets
+ * should grow when a resumed Toker is cancelled at the same checkpoint.
+ *
+ *   TokCancel budget;
+ *   budget.setBudget(std::chrono::milliseconds(5));
+ *   toker.setCancel(&budget);
+ *   while ((tok = toker.getTok()) != "") ...
+ *   if (toker.cancelled()) save(toker.checkpoint());
+ *
+ * skipBlock(), called just after getTok() returns {, reads straight to
+ * the matching } without forming tokens, so indexers that only want
+ * declarations can pass over function bodies quickly.  Comments and
+ * quoted text are delimited exactly as getTok() would delimit them, so
+ * the braces it counts are the { and } tokens getTok() would return.
+ * Preprocessor lines are not understood, so unbalanced braces in #if
+ * branches throw the count off, as they do for SemiExp.
+ *
  * Build Process:
  * --------------
- * Required Files: Tokenizer.h, Tokenizer.cpp
+ * Required Files: Tokenizer.h, Tokenizer.cpp, ITokSource.h
  * Build Command: devenv Tokenizer.sln /rebuild debug
  *
  * Maintenance History:
  * --------------------
+ * ver 4.5 : 19 Oct 2026
+ * - tokContinues() is part of ITokSource, so SemiExp can join pieces
+ * ver 4.4 : 19 Oct 2026
+ * - added skipBlock(), which passes over a brace-enclosed body without
+ *   tokenizing it, still minding comments and quoted text
+ * ver 4.3 : 19 Oct 2026
+ * - added TokCancel and Toker::setCancel(): a cancelled or timed-out
+ *   Toker stops within a few thousand characters, even inside a token,
+ *   and checkpoint() gives the start of the unfinished token
+ * ver 4.2 : 19 Oct 2026
+ * - added TokerConfig::setMaxTokenSize() and Toker::tokContinues(), so a
+ *   huge comment or literal arrives in bounded pieces
+ * ver 4.1 : 19 Oct 2026
+ * - Toker implements ITokSource, so SemiExp can also read tokens from
+ *   sources other than a Toker
+ * ver 4.0 : 19 Oct 2026
+ * - added checkpoint() and resume(), so scanning can stop at any token
+ *   boundary and continue later, possibly in another process
+ * ver 3.9 : 19 Oct 2026
+ * - added reset(), which rewinds a Toker onto a new stream without
+ *   reallocating, and setConfig()
+ * ver 3.8 : 19 Oct 2026
+ * - added TokerConfig, lookup tables shared read-only by Tokers, which
+ *   replaces the static special character maps and collectComments flag
+ * - setters now change only their own Toker and no longer write to
+ *   std::cout
+ * ver 3.7 : 19 Oct 2026
+ * - added tokOffset(), the stream offset where the last token started.
+ *   Tokens carry no line numbers; resolve offsets with a LineIndex.
+ * ver 3.6 : 19 Oct 2026
+ * - moved scanner state out of ConsumeState statics into a Context owned
+ *   by each Toker, so separate Tokers can run concurrently on separate
+ *   threads
+ * - removed setConstructorDestructorflag(), no longer needed
  * ver 3.5 : 08 Feb 2016
  * - added functions for adding special characters and option to include 
  *   comments in token
@@ -60,26 +141,89 @@
  */
 #include <iosfwd>
 #include <string>
+#include <memory>
+#include <bitset>
+#include <atomic>
+#include <chrono>
+#include "ITokSource.h"
 
 namespace Scanner
 {
   class ConsumeState;
-  
-  class Toker
+  struct Context;
+
+  class TokerConfig
+  {
+  public:
+    TokerConfig();      // default special chars, comments not collected
+    bool addSpecialSingleChar(char ch);                //false if already present
+    bool addSpecialCharPair(const std::string& pair);  //false if present or not two chars
+    void setCollectComments(bool value);
+    void setMaxTokenSize(size_t size);                 //0 for no cap
+    bool isSpecialSingleChar(int ch) const { return _singles[ch & 0xff]; }
+    bool isSpecialCharPair(int first, int second) const { return _pairs[(first & 0xff) << 8 | (second & 0xff)]; }
+    bool collectComments() const { return _collectComments; }
+    size_t maxTokenSize() const { return _maxTokenSize; }
+    static std::shared_ptr<const TokerConfig> defaults();
+  private:
+    std::bitset<256> _singles;
+    std::bitset<256 * 256> _pairs;
+    bool _collectComments;
+    size_t _maxTokenSize;
+  };
+
+  //--restart point between two tokens
+  struct TokerCheckpoint
+  {
+    size_t offset;     // offset of the first character not yet tokenized
+    int lookahead;     // the character at offset, EOF if none was read
+    std::string serialize() const;
+    static bool parse(const std::string& text, TokerCheckpoint& cp);
+  };
+
+  //--stops the Tokers watching it, on cancel() or once its deadline
+  //  passes; any thread may cancel or move the deadline
+  class TokCancel
+  {
+  public:
+    using Clock = std::chrono::steady_clock;
+    TokCancel() : _cancelled(false), _deadline(0) {}
+    void cancel() { _cancelled = true; }
+    void setDeadline(Clock::time_point deadline) { _deadline = deadline.time_since_epoch().count(); }
+    void setBudget(Clock::duration budget) { setDeadline(Clock::now() + budget); }
+    void clear() { _cancelled = false; _deadline = 0; }
+    bool expired() const;
+  private:
+    std::atomic<bool> _cancelled;
+    std::atomic<Clock::rep> _deadline;   // 0 for none
+  };
+
+  class Toker : public ITokSource
   {
   public:
 	Toker();
+    explicit Toker(std::shared_ptr<const TokerConfig> config);
     Toker(const Toker&) = delete;
     ~Toker();
     Toker& operator=(const Toker&) = delete;
     bool attach(std::istream* pIn);
-    std::string getTok();
+    bool reset(std::istream* pIn);   //forgets the previous stream entirely
+    void setConfig(std::shared_ptr<const TokerConfig> config);
+    virtual std::string getTok();
     bool canRead();
+    virtual size_t tokOffset();   //offset of the first char of the last token
+    virtual bool tokContinues();  //last token was cut; getTok() returns the rest
+    void setCancel(const TokCancel* pCancel);   //nullptr for none
+    virtual bool cancelled();     //getTok() stopped on the TokCancel
+    virtual bool skipBlock(size_t& newlines, bool& closed);   //after getTok() returned {
+    TokerCheckpoint checkpoint();   //logic_error if tokContinues() and not cancelled()
+    bool resume(std::istream* pIn, const TokerCheckpoint& cp);   //seeks pIn to cp
 	bool setSpecialSingleChars(std::string ssc);   //adds special single chars
 	bool setSpecialCharPairs(std::string scp);     //adds special char pairs
 	void setCollectComments(bool value);  //true value collects tokens else doesn't
-	void setConstructorDestructorflag();
+    std::shared_ptr<const TokerConfig> config() const;
   private:
+    Context* _pContext;
     ConsumeState* pConsumer;
   };
 }
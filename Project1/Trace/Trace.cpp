@@ -0,0 +1,324 @@
+///////////////////////////////////////////////////////////////////////
+// Trace.cpp - latency histograms and Chrome trace spans for scanning//
+// ver 1.0                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* Histogram buckets: values below 32 have a bucket each.  Above that a
+* value with its highest set bit at position m goes to one of 16 buckets
+* for [2^m, 2^(m+1)), chosen by the 4 bits below the highest, so a
+* bucket is never wider than 1/16 of its lower bound.  Percentiles report
+* the bucket's highest value, capped at the largest value recorded.
+*
+* A thread finds its ThreadLog through a thread_local list keyed by
+* recorder id, so the lock is taken once per thread per recorder.  Ids,
+* unlike addresses, are never reused by a later recorder.
+*
+* Build Process:
+* --------------
+* Required Files: Trace.h, Trace.cpp, ITokSource.h
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <algorithm>
+#include <cmath>
+#include "Trace.h"
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+using namespace Scanner;
+
+namespace
+{
+  const size_t SubBits = 4;                               // 16 buckets per power of two
+  const size_t Linear = size_t(2) << SubBits;             // values with a bucket each
+  const size_t Buckets = (64 - SubBits) * (size_t(1) << SubBits) + (size_t(1) << SubBits);
+
+  size_t highestBit(uint64_t value)
+  {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return index;
+#else
+    return 63 - __builtin_clzll(value);
+#endif
+  }
+
+  std::atomic<uint64_t> nextRecorderId(1);
+
+  struct LocalLog
+  {
+    uint64_t id;
+    void* pLog;
+  };
+  thread_local std::vector<LocalLog> localLogs;
+
+  void putJson(std::ostream& out, const std::string& str)
+  {
+    out << '"';
+    for (char ch : str)
+    {
+      if (ch == '"' || ch == '\\')
+        out << '\\' << ch;
+      else if (static_cast<unsigned char>(ch) < 0x20)
+        out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(ch) << std::dec << std::setfill(' ');
+      else
+        out << ch;
+    }
+    out << '"';
+  }
+}
+
+//----< LatencyHistogram >-------------------------------------------
+
+LatencyHistogram::LatencyHistogram() : _counts(Buckets, 0), _count(0), _sum(0), _min(UINT64_MAX), _max(0) {}
+
+size_t LatencyHistogram::bucket(uint64_t value)
+{
+  if (value < Linear)
+    return static_cast<size_t>(value);
+  size_t shift = highestBit(value) - SubBits;
+  return shift * (size_t(1) << SubBits) + static_cast<size_t>(value >> shift);
+}
+
+uint64_t LatencyHistogram::highest(size_t bucket)
+{
+  if (bucket < Linear)
+    return bucket;
+  size_t shift = bucket / (size_t(1) << SubBits) - 1;
+  uint64_t top = bucket % (size_t(1) << SubBits) + (size_t(1) << SubBits);
+  return ((top + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t value)
+{
+  ++_counts[bucket(value)];
+  ++_count;
+  _sum += value;
+  _min = std::min(_min, value);
+  _max = std::max(_max, value);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other)
+{
+  for (size_t i = 0; i < Buckets; ++i)
+    _counts[i] += other._counts[i];
+  _count += other._count;
+  _sum += other._sum;
+  _min = std::min(_min, other._min);
+  _max = std::max(_max, other._max);
+}
+
+void LatencyHistogram::clear()
+{
+  std::fill(_counts.begin(), _counts.end(), 0);
+  _count = _sum = _max = 0;
+  _min = UINT64_MAX;
+}
+
+uint64_t LatencyHistogram::percentile(double percent) const
+{
+  if (_count == 0)
+    return 0;
+  uint64_t rank = static_cast<uint64_t>(std::ceil(percent / 100.0 * _count));
+  rank = std::max<uint64_t>(1, std::min(rank, _count));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < Buckets; ++i)
+  {
+    seen += _counts[i];
+    if (seen >= rank)
+      return std::min(highest(i), _max);
+  }
+  return _max;
+}
+
+//----< TraceRecorder >----------------------------------------------
+
+const char* Scanner::phaseName(Phase phase)
+{
+  static const char* names[PhaseCount] = { "open", "scan", "group", "output", "file" };
+  return names[static_cast<size_t>(phase)];
+}
+
+TraceRecorder::TraceRecorder(bool keepSpans)
+  : _origin(std::chrono::steady_clock::now()), _keepSpans(keepSpans), _id(nextRecorderId++) {}
+
+uint64_t TraceRecorder::now() const
+{
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now() - _origin).count());
+}
+
+//--the calling thread's log, made on its first use of this recorder
+TraceRecorder::ThreadLog& TraceRecorder::local()
+{
+  for (auto& entry : localLogs)
+    if (entry.id == _id)
+      return *static_cast<ThreadLog*>(entry.pLog);
+  std::lock_guard<std::mutex> lock(_mutex);
+  _logs.push_back(std::unique_ptr<ThreadLog>(new ThreadLog));
+  ThreadLog* pLog = _logs.back().get();
+  pLog->tid = _logs.size();
+  localLogs.push_back(LocalLog{ _id, pLog });
+  return *pLog;
+}
+
+void TraceRecorder::record(Phase phase, uint64_t nanoseconds)
+{
+  local().histograms[static_cast<size_t>(phase)].record(nanoseconds);
+}
+
+void TraceRecorder::span(Phase phase, const std::string& name, uint64_t start, uint64_t end)
+{
+  ThreadLog& log = local();
+  log.histograms[static_cast<size_t>(phase)].record(end - start);
+  if (_keepSpans)
+    log.events.push_back(Event{ phase, name, start, end - start });
+}
+
+LatencyHistogram TraceRecorder::histogram(Phase phase) const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  LatencyHistogram result;
+  for (auto& pLog : _logs)
+    result.merge(pLog->histograms[static_cast<size_t>(phase)]);
+  return result;
+}
+
+size_t TraceRecorder::threads() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _logs.size();
+}
+
+//--one line per phase that was recorded, latencies in microseconds
+void TraceRecorder::report(std::ostream& out) const
+{
+  auto us = [](uint64_t ns) { return ns / 1000.0; };
+  out << "\n  phase        count       p50       p99      p999       max  (us)";
+  out << std::fixed << std::setprecision(1);
+  for (size_t i = 0; i < PhaseCount; ++i)
+  {
+    LatencyHistogram h = histogram(static_cast<Phase>(i));
+    if (h.count() == 0)
+      continue;
+    out << "\n  " << std::left << std::setw(8) << phaseName(static_cast<Phase>(i)) << std::right
+        << std::setw(9) << h.count() << std::setw(10) << us(h.percentile(50))
+        << std::setw(10) << us(h.percentile(99)) << std::setw(10) << us(h.percentile(99.9))
+        << std::setw(10) << us(h.max());
+  }
+  out.unsetf(std::ios::floatfield);
+  out << std::setprecision(6);
+}
+
+//--trace event format: complete ("X") events, microsecond timestamps
+bool TraceRecorder::writeChromeTrace(const std::string& path) const
+{
+  std::ofstream out(path, std::ios::binary);
+  if (!out.good())
+    return false;
+  std::lock_guard<std::mutex> lock(_mutex);
+  out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  out << std::fixed << std::setprecision(3);
+  bool first = true;
+  for (auto& pLog : _logs)
+  {
+    out << (first ? "\n" : ",\n") << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << pLog->tid
+        << ",\"args\":{\"name\":\"thread " << pLog->tid << "\"}}";
+    first = false;
+    for (auto& event : pLog->events)
+    {
+      out << ",\n{\"ph\":\"X\",\"cat\":\"" << phaseName(event.phase) << "\",\"name\":";
+      putJson(out, event.name != "" ? event.name : phaseName(event.phase));
+      out << ",\"pid\":1,\"tid\":" << pLog->tid << ",\"ts\":" << event.start / 1000.0
+          << ",\"dur\":" << event.duration / 1000.0 << "}";
+    }
+  }
+  out << "\n]}\n";
+  return out.good();
+}
+
+//----< TimedSource >------------------------------------------------
+
+std::string TimedSource::getTok()
+{
+  uint64_t start = _pTrace->now();
+  std::string tok = _pSource->getTok();
+  _pTrace->record(Phase::Scan, _pTrace->now() - start);
+  return tok;
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_TRACE
+
+#include <cstdio>
+#include <thread>
+#include "../Tokenizer/Tokenizer.h"
+#include "../SemiExp/SemiExp.h"
+
+int main()
+{
+  std::cout << "\n  <-----------Latency Histograms------------> \n";
+
+  LatencyHistogram h;
+  for (uint64_t v = 1; v <= 100000; ++v)
+    h.record(v);
+  std::cout << "\n  1..100000: p50 " << h.percentile(50) << ", p99 " << h.percentile(99)
+            << ", p999 " << h.percentile(99.9) << ", max " << h.max();
+
+  std::vector<std::string> files = {
+    "../Tokenizer/Tokenizer.cpp", "../SemiExp/SemiExp.cpp",
+    "../Tokenizer/Tokenizer.h", "../SemiExp/SemiExp.h"
+  };
+  TraceRecorder trace(true);
+  auto worker = [&](size_t first) {
+    for (size_t i = first; i < files.size(); i += 2)
+    {
+      TraceSpan fileSpan(&trace, Phase::File, files[i]);
+      std::ifstream in;
+      {
+        TraceSpan open(&trace, Phase::Open, files[i]);
+        in.open(files[i]);
+      }
+      Toker toker;
+      toker.attach(&in);
+      TimedSource timed(&toker, &trace);
+      SemiExp semi(&timed);
+      bool more = true;
+      while (more)
+      {
+        uint64_t start = trace.now();
+        more = semi.get();
+        trace.record(Phase::Group, trace.now() - start);
+      }
+    }
+  };
+  std::thread other(worker, 1);
+  worker(0);
+  other.join();
+
+  std::cout << "\n\n  " << files.size() << " files on " << trace.threads() << " threads";
+  trace.report(std::cout);
+  std::string path = "trace_test.json";
+  std::cout << "\n\n  chrome trace " << (trace.writeChromeTrace(path) ? "written" : "NOT written");
+  std::remove(path.c_str());
+  std::cout << "\n\n";
+  return 0;
+}
+#endif
@@ -0,0 +1,168 @@
+#ifndef TRACE_H
+#define TRACE_H
+///////////////////////////////////////////////////////////////////////
+// Trace.h - latency histograms and Chrome trace spans for scanning  //
+// ver 1.1                                                           //
+// Language:    C++, Visual Studio 2015                              //
+// Application: Parser component, CSE687 - Object Oriented Design    //
+// Author:      Satish Goswami, Syracuse University                  //
+//              sgoswami@syr.edu                                     //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package measures where tokenizing time goes.  A TraceRecorder
+* keeps one LatencyHistogram per Phase:
+*   Open   - opening a file
+*   Scan   - one Toker::getTok() call
+*   Group  - one SemiExp::get() call, including the getTok() calls it
+*            made when those are timed too
+*   Output - writing one file's results
+*   File   - one file from start to end
+* LatencyHistogram is HDR-style: values fall into buckets whose width
+* grows with the value, 16 to each power of two, so a percentile is
+* reported as the top of its bucket, less than 6.25% (1/16) above the
+* latency recorded at any magnitude; percentiles such as p99 and p999
+* come out of a fixed 8KB table, and histograms merge by adding counts.
+*
+* Instrumentation is opt-in and costs nothing when absent.  TraceSpan
+* times a block and is a no-op given a null recorder; TimedSource is an
+* ITokSource that times each getTok() of the source it wraps, so it can
+* be put between a Toker and a SemiExp without changing either.
+*
+* Each thread records into its own slot of the recorder, without
+* locking.  With spans enabled, every TraceSpan is also kept as a
+* Chrome trace event, and writeChromeTrace() saves them, one row per
+* thread, for chrome://tracing or Perfetto.  Read the histograms or
+* write the trace only after the recording threads have finished.
+*
+* Public Interface:
+* -----------------
+* TraceRecorder trace(true);                      // true: keep spans
+* { TraceSpan span(&trace, Phase::File, path); ... }
+* TimedSource timed(&toker, &trace);
+* SemiExp semi(&timed);
+* trace.report(std::cout);                        // count, p50, p99, p999
+* trace.writeChromeTrace("trace.json");
+*
+* Build Process:
+* --------------
+* Required Files: Trace.h, Trace.cpp, ITokSource.h
+* Build Command: devenv Project1.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 19 Oct 2026
+* - TimedSource forwards tokContinues()
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include "../Tokenizer/ITokSource.h"
+
+namespace Scanner
+{
+  class LatencyHistogram
+  {
+  public:
+    LatencyHistogram();
+    void record(uint64_t value);
+    void merge(const LatencyHistogram& other);
+    void clear();
+    uint64_t percentile(double percent) const;   //e.g. 99.9; 0 if empty
+    uint64_t count() const { return _count; }
+    uint64_t min() const { return _count > 0 ? _min : 0; }
+    uint64_t max() const { return _max; }
+    double mean() const { return _count > 0 ? double(_sum) / _count : 0.0; }
+  private:
+    static size_t bucket(uint64_t value);
+    static uint64_t highest(size_t bucket);
+    std::vector<uint64_t> _counts;
+    uint64_t _count;
+    uint64_t _sum;
+    uint64_t _min;
+    uint64_t _max;
+  };
+
+  enum class Phase { Open, Scan, Group, Output, File };
+  const size_t PhaseCount = 5;
+  const char* phaseName(Phase phase);
+
+  class TraceRecorder
+  {
+  public:
+    explicit TraceRecorder(bool keepSpans = false);
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+    uint64_t now() const;   //nanoseconds since the recorder was made
+    void record(Phase phase, uint64_t nanoseconds);
+    void span(Phase phase, const std::string& name, uint64_t start, uint64_t end);
+    LatencyHistogram histogram(Phase phase) const;   //all threads merged
+    size_t threads() const;
+    void report(std::ostream& out) const;
+    bool writeChromeTrace(const std::string& path) const;
+  private:
+    struct Event
+    {
+      Phase phase;
+      std::string name;
+      uint64_t start;
+      uint64_t duration;
+    };
+    struct ThreadLog
+    {
+      size_t tid;
+      LatencyHistogram histograms[PhaseCount];
+      std::vector<Event> events;
+    };
+    ThreadLog& local();
+    std::chrono::steady_clock::time_point _origin;
+    bool _keepSpans;
+    uint64_t _id;
+    mutable std::mutex _mutex;
+    std::vector<std::unique_ptr<ThreadLog>> _logs;
+  };
+
+  //--times the enclosing block; does nothing with a null recorder
+  class TraceSpan
+  {
+  public:
+    TraceSpan(TraceRecorder* pTrace, Phase phase, const std::string& name = "")
+      : _pTrace(pTrace), _phase(phase), _name(pTrace != nullptr ? name : ""), _start(pTrace != nullptr ? pTrace->now() : 0) {}
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+    ~TraceSpan()
+    {
+      if (_pTrace != nullptr)
+        _pTrace->span(_phase, _name, _start, _pTrace->now());
+    }
+  private:
+    TraceRecorder* _pTrace;
+    Phase _phase;
+    std::string _name;
+    uint64_t _start;
+  };
+
+  //--an ITokSource that records the latency of each getTok() as Scan
+  class TimedSource : public ITokSource
+  {
+  public:
+    TimedSource(ITokSource* pSource, TraceRecorder* pTrace) : _pSource(pSource), _pTrace(pTrace) {}
+    virtual std::string getTok();
+    virtual size_t tokOffset() { return _pSource->tokOffset(); }
+    virtual bool cancelled() { return _pSource->cancelled(); }
+    virtual bool tokContinues() { return _pSource->tokContinues(); }
+    virtual bool skipBlock(size_t& newlines, bool& closed) { return _pSource->skipBlock(newlines, closed); }
+  private:
+    ITokSource* _pSource;
+    TraceRecorder* _pTrace;
+  };
+}
+#endif